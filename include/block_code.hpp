@@ -0,0 +1,75 @@
+#ifndef PUCCH_F2_BLOCK_CODE_HPP
+#define PUCCH_F2_BLOCK_CODE_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pucch_f2 {
+
+inline constexpr std::array<int, 5> kValidCodeLengths = {2, 4, 6, 8, 11};
+inline constexpr int kCodewordLength = 20;
+bool ValidateCodeLength(int code_length);
+
+// Binary linear (n, k) block code with n <= 32. Codeword bit i is the parity of the information
+// bits selected by generator row i (bit j = information bit j), and bit j of a message index is
+// information bit j. The codeword and parity-check tables are built once in the constructor.
+class BlockCode {
+public:
+    static constexpr int kMaxLength = 32;
+    static constexpr int kMaxDimension = 13;
+
+    BlockCode(std::string name, int n, int k, std::vector<uint32_t> generator_rows);
+
+    const std::string& Name() const { return name_; }
+    int N() const { return n_; }
+    int K() const { return k_; }
+    int NumCodewords() const { return 1 << k_; }
+
+    // Codeword of a message index, one byte per codeword bit.
+    const uint8_t* CodewordBits(uint32_t message) const {
+        return &codeword_bits_[static_cast<std::size_t>(message) * n_];
+    }
+    // Codeword of a message index packed as bit i = codeword bit i.
+    uint32_t Codeword(uint32_t message) const { return codewords_[message]; }
+
+    // Finds the message of a packed hard decision if it is a codeword, by a syndrome check
+    // against the parity-check matrix and a lookup over the information set.
+    bool LookupMessage(uint32_t hard_decision, uint32_t& message) const;
+    // False if two messages share a codeword; LookupMessage then always fails.
+    bool IsFullRank() const { return full_rank_; }
+    int MinimumDistance() const;
+
+private:
+    void BuildParityChecks();
+
+    std::string name_;
+    int n_;
+    int k_;
+    std::vector<uint32_t> generator_rows_;
+
+    std::vector<uint32_t> codewords_;
+    std::vector<uint8_t> codeword_bits_;
+
+    // Rows of the parity-check matrix as masks over codeword positions.
+    std::vector<uint32_t> parity_checks_;
+    // Pivot positions of the row-reduced generator and the message index each one adds.
+    std::vector<int> information_set_;
+    std::vector<uint32_t> information_messages_;
+    bool full_rank_ = false;
+};
+
+// Registered codes by name and dimension; each descriptor is built on first use and shared.
+const BlockCode& GetBlockCode(const std::string& name, int k);
+// The PUCCH format 2 (20, A) code, A in kValidCodeLengths.
+const BlockCode& PucchF2Code(int code_length);
+std::vector<std::string> BlockCodeNames();
+std::vector<int> BlockCodeDimensions(const std::string& name);
+
+inline constexpr const char* kPucchF2CodeName = "pucch_f2";
+inline constexpr const char* kReedMuller32CodeName = "reed_muller_32";
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_BLOCK_CODE_HPP
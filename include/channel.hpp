@@ -2,19 +2,36 @@
 #define PUCCH_F2_AWGN_HPP
 
 #include <complex>
+#include <cstddef>
 #include <cstdint>
-#include <random>
 #include <vector>
 
+#include "frame_rng.hpp"
+
 namespace pucch_f2 {
 
 class AwgnChannel {
 public:
     explicit AwgnChannel(double snr_db, uint32_t seed = 5489u);
     std::vector<std::complex<double>> Transmit(const std::vector<std::complex<double>>& symbols);
+    // Same as Transmit, and also returns the noise sample drawn for each symbol in `noise`.
+    std::vector<std::complex<double>> Transmit(const std::vector<std::complex<double>>& symbols,
+                                               std::vector<std::complex<double>>& noise);
+    // Positions the noise generator at the start of a frame; a new channel starts at frame 0.
+    void Seek(uint64_t frame);
+
+    // Unit-variance complex Gaussian samples (N(0, 1) per component); Transmit adds the same
+    // samples scaled by Sigma(snr_db) for the same generator state.
+    std::vector<std::complex<double>> GenerateUnitNoise(std::size_t count);
+
+    static double Sigma(double snr_db);
 
 private:
-    std::mt19937 random_generator_;
+    std::vector<std::complex<double>> Transmit(const std::vector<std::complex<double>>& symbols,
+                                               std::vector<std::complex<double>>* noise);
+
+    uint32_t seed_;
+    FrameRng random_generator_;
     double sigma_;
 };
 
@@ -0,0 +1,48 @@
+#ifndef PUCCH_F2_CRN_SWEEP_HPP
+#define PUCCH_F2_CRN_SWEEP_HPP
+
+#include "block_code.hpp"
+#include "channel.hpp"
+#include "decoder.hpp"
+#include "demodulator.hpp"
+#include "simulation.hpp"
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace pucch_f2 {
+
+// BLER sweep over several code lengths and SNR points with common random numbers: every
+// frame draws one block of unit noise, scales it for each SNR point and decodes the result
+// with every code length. The code is linear and the channel symmetric, so the all-zero
+// codeword is transmitted and any non-zero decoded index is a block error.
+class CrnSweep {
+public:
+    CrnSweep(const std::vector<int>& code_lengths, const std::vector<double>& snr_points_db,
+             uint32_t seed);
+    // Codes of different lengths share the noise of their common leading symbols.
+    static CrnSweep ForCodes(const std::vector<const BlockCode*>& codes,
+                             const std::vector<double>& snr_points_db, uint32_t seed);
+
+    // Statistics indexed as [code index][SNR point index].
+    std::vector<std::vector<SimulationStats>> Run(const FrameRange& range);
+
+private:
+    explicit CrnSweep(uint32_t seed);
+    void Init(const std::vector<const BlockCode*>& codes,
+              const std::vector<double>& snr_points_db);
+
+    std::vector<const BlockCode*> codes_;
+    std::vector<double> snr_points_db_;
+    std::vector<double> sigmas_;
+    uint32_t seed_;
+
+    AwgnChannel channel_;
+    QpskDemodulator demodulator_;
+    std::vector<Decoder> decoders_;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_CRN_SWEEP_HPP
@@ -1,6 +1,8 @@
 #ifndef PUCCH_F2_DECODER_HPP
 #define PUCCH_F2_DECODER_HPP
 
+#include "block_code.hpp"
+
 #include <cstdint>
 #include <vector>
 
@@ -8,24 +10,38 @@ namespace pucch_f2 {
 
 class Decoder {
 public:
+    // PUCCH format 2 code of the given number of information bits.
     explicit Decoder(int code_length);
+    explicit Decoder(const BlockCode& code);
 
     std::vector<uint8_t> Decode(const std::vector<double>& llr_values);
+    // Index of the ML codeword; bit i of the index is information bit i.
+    int DecodeIndex(const std::vector<double>& llr_values);
+    // Correlation metric of every candidate codeword, indexed like DecodeIndex.
+    std::vector<double> ComputeMetrics(const std::vector<double>& llr_values);
+
+    // Calls to DecodeIndex, and how many of them the hard-decision fast path answered.
+    int64_t DecodeCalls() const { return decode_calls_; }
+    int64_t FastPathHits() const { return fast_path_hits_; }
+    void SetFastPathEnabled(bool enabled);
 
 private:
-    static constexpr int kCodewordLength = 20;
-    static constexpr int kMaxCodeLength = 13;
+    // The fast path needs min |llr| above this share of sum |llr|, so that rounding in the
+    // full search cannot rank another candidate at or above the hard decision.
+    static constexpr double kReliabilityEpsilon = 1e-12;
 
-    int code_length_;
-    int num_codewords_;
+    const BlockCode* code_;
+    bool fast_path_enabled_ = true;
 
-    static inline std::vector<std::vector<uint8_t>> codeword_table_;
+    int64_t decode_calls_ = 0;
+    int64_t fast_path_hits_ = 0;
 
-    void BuildCodewordTable();
+    void ValidateLlrSize(const std::vector<double>& llr) const;
+    bool TryFastPath(const std::vector<double>& llr, int& index) const;
 
-    double ComputeMetric(const std::vector<uint8_t>& codeword, const std::vector<double>& llr);
+    double ComputeMetric(const uint8_t* codeword, const std::vector<double>& llr) const;
 };
 
 } // namespace pucch_f2
 
-#endif // PUCCH_F2_DECODER_HPP
\ No newline at end of file
+#endif // PUCCH_F2_DECODER_HPP
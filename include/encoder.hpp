@@ -1,7 +1,8 @@
 #ifndef PUCCH_F2_ENCODER_HPP
 #define PUCCH_F2_ENCODER_HPP
 
-#include <array>
+#include "block_code.hpp"
+
 #include <cstdint>
 #include <vector>
 
@@ -9,22 +10,16 @@ namespace pucch_f2 {
 
 class Encoder {
 public:
+    // PUCCH format 2 code of the given number of information bits.
     explicit Encoder(int code_length);
+    explicit Encoder(const BlockCode& code);
 
     std::vector<uint8_t> Encode(const std::vector<uint8_t>& data);
 
 private:
-    static constexpr int kCodewordLength = 20;
-    static constexpr int kMaxCodeLength = 13;
-    static const std::array<std::array<uint8_t, kMaxCodeLength>, kCodewordLength> kGeneratorMatrix;
-
-    int code_length_;
+    const BlockCode* code_;
 };
 
-inline constexpr std::array<int, 5> kValidCodeLengths = {2, 4, 6, 8, 11};
-inline constexpr int kCodewordLength = 20;
-bool ValidateCodeLength(int code_length);
-
 } // namespace pucch_f2
 
-#endif // PUCCH_F2_ENCODER_HPP
\ No newline at end of file
+#endif // PUCCH_F2_ENCODER_HPP
@@ -0,0 +1,53 @@
+#ifndef PUCCH_F2_FRAME_RNG_HPP
+#define PUCCH_F2_FRAME_RNG_HPP
+
+#include <cstdint>
+#include <limits>
+
+namespace pucch_f2 {
+
+enum class RngPurpose : uint32_t {
+    kMessage = 0,
+    kNoise = 1,
+    kFading = 2,
+};
+
+// Counter-based generator: the output sequence is SplitMix64 of a key derived from
+// (seed, frame index, purpose) plus a counter, so the randomness of any frame is available in
+// O(1) without generating the frames before it.
+class FrameRng {
+public:
+    using result_type = uint64_t;
+
+    FrameRng(uint64_t seed, uint64_t frame, RngPurpose purpose)
+        : key_(Mix(Mix(seed ^ (static_cast<uint64_t>(purpose) << 56)) ^ frame)), counter_(0) {}
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() {
+        return Mix(key_ + kGolden * ++counter_);
+    }
+
+    static uint64_t Mix(uint64_t x) {
+        x += kGolden;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+private:
+    static constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ULL;
+
+    uint64_t key_;
+    uint64_t counter_;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_FRAME_RNG_HPP
@@ -0,0 +1,53 @@
+#ifndef PUCCH_F2_LATENCY_BENCHMARK_HPP
+#define PUCCH_F2_LATENCY_BENCHMARK_HPP
+
+#include "block_code.hpp"
+#include "latency_histogram.hpp"
+
+#include <cstdint>
+
+namespace pucch_f2 {
+
+struct LatencyBenchmarkOptions {
+    double snr_db = 0.0;
+    int64_t iterations = 100000;
+    // Frames decoded before recording starts, to warm caches and the branch predictor.
+    int64_t warmup_iterations = 1000;
+    // Core of the measuring thread, or -1 to leave it unpinned.
+    int pin_core = -1;
+    // Per-frame demod + decode budget in microseconds; 0 disables deadline accounting.
+    double deadline_us = 0.0;
+    // Threads running the full simulation chain next to the measured one.
+    int load_threads = 0;
+};
+
+struct LatencyBenchmarkResult {
+    int code_length = 0;
+    LatencyHistogram decode;
+    LatencyHistogram demod_decode;
+    int64_t deadline_misses = 0;
+    int64_t failed = 0;
+    // Cost of one clock read, already included in every recorded latency.
+    uint64_t clock_overhead_ns = 0;
+};
+
+// Times every Decoder::Decode call, and demodulation plus decoding of the same frame, one
+// frame at a time as a real-time receiver would see it. Frame generation and the channel run
+// outside the timed region.
+class LatencyBenchmark {
+public:
+    LatencyBenchmark(const LatencyBenchmarkOptions& options, uint32_t seed);
+
+    LatencyBenchmarkResult Run(int code_length);
+    LatencyBenchmarkResult Run(const BlockCode& code);
+
+private:
+    void Measure(const BlockCode& code, LatencyBenchmarkResult& result);
+
+    LatencyBenchmarkOptions options_;
+    uint32_t seed_;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_LATENCY_BENCHMARK_HPP
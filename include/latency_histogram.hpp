@@ -0,0 +1,42 @@
+#ifndef PUCCH_F2_LATENCY_HISTOGRAM_HPP
+#define PUCCH_F2_LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace pucch_f2 {
+
+// Log-bucket histogram of latencies in nanoseconds. Every power-of-two range is split into
+// kSubBuckets linear buckets, so recording is O(1) and any reported percentile is within
+// 1 / kSubBuckets of the recorded value while the whole uint64 range fits in a fixed table.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kNumBuckets = (65 - kSubBucketBits) * kSubBuckets;
+
+    void Record(uint64_t value_ns);
+    void Merge(const LatencyHistogram& other);
+
+    uint64_t Count() const { return count_; }
+    uint64_t Min() const { return count_ > 0 ? min_ : 0; }
+    uint64_t Max() const { return max_; }
+    double Mean() const;
+    // Smallest bucket bound below which at least `percentile` percent of the values lie.
+    uint64_t Percentile(double percentile) const;
+
+    static int BucketIndex(uint64_t value_ns);
+    static uint64_t BucketLowerBound(int index);
+    static uint64_t BucketUpperBound(int index);
+
+private:
+    std::array<uint64_t, kNumBuckets> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+    long double sum_ = 0.0L;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,67 @@
+#ifndef PUCCH_F2_PIPELINE_HPP
+#define PUCCH_F2_PIPELINE_HPP
+
+#include "simulation.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pucch_f2 {
+
+struct PipelineOptions {
+    std::size_t queue_capacity = 4;
+    // Either empty or one core per stage (generate, channel, decode).
+    std::vector<int> pin_cores;
+};
+
+struct PipelineStageStats {
+    std::string name;
+    int64_t batches = 0;
+    double busy_seconds = 0.0;
+    int64_t starved_waits = 0;
+};
+
+struct PipelineQueueStats {
+    std::string name;
+    std::size_t capacity = 0;
+    double mean_occupancy = 0.0;
+    std::size_t max_occupancy = 0;
+    int64_t full_waits = 0;
+};
+
+struct PipelineStats {
+    std::array<PipelineStageStats, 3> stages;
+    std::array<PipelineQueueStats, 2> queues;
+    double wall_seconds = 0.0;
+};
+
+// Runs the simulation as three concurrent stages (generate + encode + modulate, channel
+// noise, demodulate + decode + compare) connected by SPSC ring buffers of stream batches.
+// Results are identical to ChannelSimulator::Run over the same range.
+class PipelineSimulator {
+public:
+    static constexpr int kNumStages = 3;
+
+    PipelineSimulator(int code_length, double snr_db, uint32_t seed,
+                      const PipelineOptions& options);
+    PipelineSimulator(const BlockCode& code, double snr_db, uint32_t seed,
+                      const PipelineOptions& options);
+
+    SimulationStats Run(const FrameRange& range);
+
+    void SetFailedFramesLimit(std::size_t limit);
+
+    const PipelineStats& Stats() const;
+
+private:
+    ChannelSimulator simulator_;
+    PipelineOptions options_;
+    PipelineStats stats_;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_PIPELINE_HPP
@@ -0,0 +1,65 @@
+#ifndef PUCCH_F2_PUCCH_GRID_HPP
+#define PUCCH_F2_PUCCH_GRID_HPP
+
+#include <array>
+#include <complex>
+#include <vector>
+
+namespace pucch_f2 {
+
+// One PRB of one subframe with normal cyclic prefix: 12 subcarriers by 14 SC-FDMA symbols.
+inline constexpr int kNumSubcarriers = 12;
+inline constexpr int kNumGridSymbols = 14;
+inline constexpr int kNumDataSymbols = 10;
+inline constexpr int kNumDmrsSymbols = 4;
+// Cyclic shifts of the base sequence; each UE sharing the PRB uses a different one.
+inline constexpr int kNumCyclicShifts = kNumSubcarriers;
+
+// Indexed [symbol][subcarrier].
+using ResourceGrid =
+    std::array<std::array<std::complex<double>, kNumSubcarriers>, kNumGridSymbols>;
+
+// SC-FDMA symbols carrying the 10 QPSK symbols and the DMRS (l = 1, 5 in each slot).
+extern const std::array<int, kNumDataSymbols> kDataSymbolIndices;
+extern const std::array<int, kNumDmrsSymbols> kDmrsSymbolIndices;
+
+// Unimodular length-12 base sequence r(n): the length-11 Zadoff-Chu sequence with root 1,
+// cyclically extended.
+const std::array<std::complex<double>, kNumSubcarriers>& BaseSequence();
+
+// Spreads the QPSK symbols of one UE with its cyclic shift of the base sequence and adds them,
+// together with the DMRS, to the grid scaled by the UE's channel coefficient.
+class PucchGridMapper {
+public:
+    explicit PucchGridMapper(int cyclic_shift);
+
+    void Map(const std::vector<std::complex<double>>& symbols, std::complex<double> channel,
+             ResourceGrid& grid) const;
+
+private:
+    std::array<std::complex<double>, kNumSubcarriers> sequence_;
+};
+
+// Separates all UEs of a PRB at once: per SC-FDMA symbol, removes the base sequence and takes a
+// 12-point DFT across subcarriers, whose bin m is the despread value of cyclic shift m.
+class PucchGridReceiver {
+public:
+    PucchGridReceiver();
+
+    // Output is indexed [symbol][cyclic shift].
+    void Despread(const ResourceGrid& grid, ResourceGrid& despread) const;
+
+    // Least-squares channel estimate of one cyclic shift averaged over all DMRS symbols.
+    static std::complex<double> EstimateChannel(const ResourceGrid& despread, int cyclic_shift);
+    // Zero-forcing equalized QPSK symbols of one cyclic shift.
+    static std::vector<std::complex<double>>
+    Equalize(const ResourceGrid& despread, int cyclic_shift, std::complex<double> channel);
+
+private:
+    // Conjugate base sequence times the DFT twiddles, scaled by 1 / 12; [shift][subcarrier].
+    std::array<std::array<std::complex<double>, kNumSubcarriers>, kNumCyclicShifts> matrix_;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_PUCCH_GRID_HPP
@@ -0,0 +1,73 @@
+#ifndef PUCCH_F2_PUCCH_SIMULATION_HPP
+#define PUCCH_F2_PUCCH_SIMULATION_HPP
+
+#include "decoder.hpp"
+#include "demodulator.hpp"
+#include "encoder.hpp"
+#include "modulator.hpp"
+#include "pucch_grid.hpp"
+#include "simulation.hpp"
+
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pucch_f2 {
+
+enum class FadingModel {
+    kAwgn,
+    // Rayleigh block fading: one CN(0, 1) coefficient per UE and subframe.
+    kRayleigh,
+};
+
+FadingModel ParseFadingModel(const std::string& name);
+
+struct PucchSimulationResult {
+    // Frames are counted per UE, so a fully loaded PRB adds 12 frames per subframe.
+    SimulationStats stats;
+    std::vector<int64_t> failed_per_ue;
+    // Mean |h_est - h|^2 of the DMRS channel estimates.
+    double channel_estimation_mse = 0.0;
+};
+
+// Resource-grid level PUCCH format 2 link: num_ues UEs share one PRB on different cyclic
+// shifts, each sending its own codeword through its own channel, and the receiver despreads
+// all of them jointly before channel estimation, equalization and decoding. snr_db is the
+// per-RE SNR of each UE.
+class PucchSimulator {
+public:
+    PucchSimulator(int code_length, double snr_db, int num_ues, FadingModel fading,
+                   uint32_t seed);
+    // The code must fill the 10 QPSK symbols of a PUCCH format 2 resource, i.e. n = 20.
+    PucchSimulator(const BlockCode& code, double snr_db, int num_ues, FadingModel fading,
+                   uint32_t seed);
+
+    PucchSimulationResult Run(const FrameRange& range);
+
+    // Cyclic shifts of the UEs, spread evenly over the 12 available.
+    static int CyclicShift(int ue, int num_ues);
+
+private:
+    void GenerateChannels(int64_t frame);
+    void AddNoise(int64_t frame, ResourceGrid& grid) const;
+
+    int code_length_;
+    double snr_db_;
+    int num_ues_;
+    FadingModel fading_;
+    uint32_t seed_;
+
+    Encoder encoder_;
+    QpskModulator modulator_;
+    std::vector<PucchGridMapper> mappers_;
+    PucchGridReceiver receiver_;
+    QpskDemodulator demodulator_;
+    Decoder decoder_;
+
+    std::vector<std::complex<double>> channels_;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_PUCCH_SIMULATION_HPP
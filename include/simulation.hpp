@@ -0,0 +1,121 @@
+#ifndef PUCCH_F2_SIMULATION_HPP
+#define PUCCH_F2_SIMULATION_HPP
+
+#include "block_code.hpp"
+#include "channel.hpp"
+#include "decoder.hpp"
+#include "demodulator.hpp"
+#include "encoder.hpp"
+#include "modulator.hpp"
+
+#include <complex>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace pucch_f2 {
+
+struct SimulationStats {
+    int64_t frames = 0;
+    int64_t success = 0;
+    int64_t failed = 0;
+    // Frames the decoder's hard-decision fast path resolved without the full ML search.
+    int64_t fast_path_hits = 0;
+
+    // Errors per information bit position.
+    std::vector<int64_t> bit_errors;
+    // Frames by Hamming weight of the information error pattern (index 0 = decoded correctly).
+    std::vector<int64_t> error_weights;
+    // Wrongly decoded frames by decoded message index.
+    std::vector<int64_t> decoded_errors;
+    // Indices of the first failed_frames_limit failed frames, in frame order.
+    std::vector<int64_t> failed_frames;
+    std::size_t failed_frames_limit = 0;
+
+    void Resize(int code_length);
+    // Counts one frame; sent and decoded are message indices (bit i = information bit i).
+    void Record(int64_t frame, uint32_t sent, uint32_t decoded);
+    void Merge(const SimulationStats& other);
+    int64_t TotalBitErrors() const;
+};
+
+// Half-open frame range [first_frame, last_frame) of the iteration space.
+struct FrameRange {
+    int64_t first_frame;
+    int64_t last_frame;
+};
+
+// Frames are processed in batches of this size.
+inline constexpr int64_t kFramesPerBatch = 1024;
+
+// Splits [0, iterations) into shard_count contiguous ranges whose sizes differ by at most one
+// frame; shards beyond the iteration count are empty.
+FrameRange ComputeShardRange(int64_t iterations, int shard_index, int shard_count);
+
+std::pair<double, double> WilsonInterval(int64_t failed, int64_t trials, double z = 1.96);
+
+// Consecutive frames travelling through the simulation stages together.
+struct FrameBatch {
+    int64_t first_frame = 0;
+    int64_t num_frames = 0;
+    std::vector<std::vector<uint8_t>> data;
+    std::vector<std::vector<std::complex<double>>> symbols;
+};
+
+// Every intermediate value of one simulated frame.
+struct FrameTrace {
+    int64_t frame = 0;
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> codeword;
+    std::vector<std::complex<double>> symbols;
+    std::vector<std::complex<double>> noise;
+    std::vector<std::complex<double>> received;
+    std::vector<double> llr;
+    std::vector<double> metrics;
+    int sent_index = 0;
+    int decoded_index = 0;
+};
+
+// All randomness of a frame is derived from (seed, frame index), so any frame range gives the
+// same per-frame results as a full run and any single frame can be replayed in O(1).
+class ChannelSimulator {
+public:
+    ChannelSimulator(int code_length, double snr_db, uint32_t seed);
+    ChannelSimulator(const BlockCode& code, double snr_db, uint32_t seed);
+
+    SimulationStats Run(const FrameRange& range);
+
+    FrameTrace ReplayFrame(int64_t frame);
+
+    void SetFailedFramesLimit(std::size_t limit);
+
+    // Statistics of an empty frame range: sized for the code and carrying the failed-frame
+    // limit, so that a range without frames still merges with the others.
+    SimulationStats EmptyStats() const;
+
+    // Stages of a batch; each touches its own components, so the three of them may run
+    // concurrently on different batches.
+    void GenerateBatch(FrameBatch& batch);
+    void TransmitBatch(FrameBatch& batch);
+    void DecodeBatch(const FrameBatch& batch, SimulationStats& stats);
+
+    static void ValidateRange(const FrameRange& range);
+
+private:
+    void GenerateMessage(int64_t frame, std::vector<uint8_t>& data);
+
+    int code_length_;
+    double snr_db_;
+    uint32_t seed_;
+    std::size_t failed_frames_limit_ = 0;
+
+    Encoder encoder_;
+    QpskModulator modulator_;
+    AwgnChannel channel_;
+    QpskDemodulator demodulator_;
+    Decoder decoder_;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_SIMULATION_HPP
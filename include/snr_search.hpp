@@ -0,0 +1,79 @@
+#ifndef PUCCH_F2_SNR_SEARCH_HPP
+#define PUCCH_F2_SNR_SEARCH_HPP
+
+#include "block_code.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace pucch_f2 {
+
+struct SnrSearchOptions {
+    double target_bler = 0.01;
+    double snr_low_db = -10.0;
+    double snr_high_db = 10.0;
+    double tolerance_db = 0.1;
+    int64_t min_iterations = 1000;
+    int64_t max_iterations = 1000000;
+    // Normal quantile of the BLER confidence interval used to decide each probe.
+    double z = 1.96;
+};
+
+struct SnrProbe {
+    double snr_db = 0.0;
+    int64_t frames = 0;
+    int64_t failed = 0;
+    double bler_ci_low = 0.0;
+    double bler_ci_high = 1.0;
+    // False if max_iterations ran out before the interval excluded the target or fell inside
+    // the target band.
+    bool resolved = false;
+    // The interval contains the target but lies inside the band of BLERs within tolerance_db / 2
+    // of the crossing, so this SNR is taken as the answer.
+    bool at_target = false;
+
+    double Bler() const;
+    bool AboveTarget(double target_bler) const;
+};
+
+struct SnrSearchResult {
+    int code_length = 0;
+    double required_snr_db = 0.0;
+    // Final bracket: BLER is above the target at snr_low_db and below it at snr_high_db. Wider
+    // than tolerance_db only if the search stopped on a probe at the target.
+    double snr_low_db = 0.0;
+    double snr_high_db = 0.0;
+    bool resolved = true;
+    int64_t total_frames = 0;
+    std::vector<SnrProbe> probes;
+};
+
+// Finds the SNR at which the BLER of a code length crosses the target by bisection. Each probe
+// adds frames until the BLER confidence interval lies on one side of the target, so probes far
+// from the crossing are cheap and the frame budget concentrates near it. A probe so close to the
+// crossing that its interval cannot exclude the target stops once the interval is narrower than
+// the BLER change over tolerance_db, and ends the search.
+class SnrSearch {
+public:
+    explicit SnrSearch(const SnrSearchOptions& options, uint32_t seed);
+
+    SnrSearchResult Run(int code_length);
+    SnrSearchResult Run(const BlockCode& code);
+
+private:
+    static constexpr int kMaxBracketExpansions = 4;
+
+    // `band` > 1 lets the probe stop at the target when its interval lies within
+    // [target / band, target * band].
+    SnrProbe Probe(const BlockCode& code, double snr_db, double band);
+    // Band of BLERs within tolerance_db / 2 of the crossing, from the log-BLER slope between the
+    // bracket ends.
+    double TargetBand(const SnrProbe& low, const SnrProbe& high) const;
+
+    SnrSearchOptions options_;
+    uint32_t seed_;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_SNR_SEARCH_HPP
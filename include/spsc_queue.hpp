@@ -0,0 +1,84 @@
+#ifndef PUCCH_F2_SPSC_QUEUE_HPP
+#define PUCCH_F2_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pucch_f2 {
+
+// Bounded lock-free single-producer/single-consumer ring buffer. Exactly one thread may
+// call TryPush and exactly one (other) thread may call TryPop.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity) : slots_(RoundUpToPowerOfTwo(capacity)) {
+        if (capacity == 0) {
+            throw std::invalid_argument("SpscQueue capacity must be positive");
+        }
+        mask_ = slots_.size() - 1;
+    }
+
+    bool TryPush(const T& value) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == slots_.size()) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == slots_.size()) {
+                return false;
+            }
+        }
+
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& value) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently; exact once both sides are quiescent.
+    std::size_t Size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    std::size_t Capacity() const {
+        return slots_.size();
+    }
+
+private:
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    static std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::vector<T> slots_;
+    std::size_t mask_;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_ = 0;
+};
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_SPSC_QUEUE_HPP
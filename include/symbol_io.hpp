@@ -0,0 +1,22 @@
+#ifndef PUCCH_F2_SYMBOL_IO_HPP
+#define PUCCH_F2_SYMBOL_IO_HPP
+
+#include <complex>
+#include <string>
+#include <string_view>
+
+namespace pucch_f2 {
+
+// Text form of a QPSK symbol, e.g. "0.707-0.707j": real part, signed imaginary part, 'j'.
+// Both directions use std::from_chars / std::to_chars and do not touch the locale or iostreams.
+
+// Parses `text` into `value`. Returns false if `text` is not a complete symbol.
+bool ParseComplex(std::string_view text, std::complex<double>& value);
+
+// Formats with three decimals, like printf("%.3f%+.3fj"). The result fits in the small-string
+// buffer for unit-power symbols.
+std::string FormatComplex(const std::complex<double>& value);
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_SYMBOL_IO_HPP
@@ -0,0 +1,11 @@
+#ifndef PUCCH_F2_THREAD_AFFINITY_HPP
+#define PUCCH_F2_THREAD_AFFINITY_HPP
+
+namespace pucch_f2 {
+
+// Pins the calling thread to one CPU core. No-op on platforms without affinity support.
+void PinCurrentThread(int core);
+
+} // namespace pucch_f2
+
+#endif // PUCCH_F2_THREAD_AFFINITY_HPP
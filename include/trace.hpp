@@ -0,0 +1,74 @@
+#ifndef PUCCH_F2_TRACE_HPP
+#define PUCCH_F2_TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Span tracing in Chrome trace / Perfetto JSON format.
+//
+// PUCCH_TRACE_SCOPE marks batch-level spans, PUCCH_TRACE_SCOPE_FINE marks per-frame spans.
+// Both expand to nothing unless the build defines PUCCH_ENABLE_TRACE (make TRACE=1 for batch
+// spans, make TRACE=2 to also record per-frame spans). Even when compiled in, spans are only
+// recorded after trace::Enable().
+
+namespace pucch_f2::trace {
+
+// Spans recorded per thread before further ones are dropped; 24 bytes each, so about 24 MB per
+// thread. A 1M-frame TRACE=2 run records about 2M spans and keeps the first 1M of each thread.
+constexpr std::size_t kMaxEventsPerThread = std::size_t{1} << 20;
+
+void Enable();
+bool IsEnabled();
+bool IsCompiledIn();
+
+// Name shown for the calling thread in the trace viewer.
+void SetThreadName(const std::string& name);
+
+// Writes every span recorded so far by all threads. Must not race with recording threads.
+void WriteChromeTrace(const std::string& path);
+
+// Number of spans recorded so far by all threads. Safe to call while threads are recording.
+std::size_t EventCount();
+
+// Number of spans dropped so far because their thread reached kMaxEventsPerThread.
+std::size_t DroppedEventCount();
+
+class ScopedSpan {
+public:
+    explicit ScopedSpan(const char* name);
+    ~ScopedSpan();
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+    const char* name_;
+    uint64_t start_ns_;
+};
+
+} // namespace pucch_f2::trace
+
+#define PUCCH_TRACE_CONCAT_IMPL(a, b) a##b
+#define PUCCH_TRACE_CONCAT(a, b) PUCCH_TRACE_CONCAT_IMPL(a, b)
+
+#ifndef PUCCH_TRACE_LEVEL
+#define PUCCH_TRACE_LEVEL 1
+#endif
+
+#ifdef PUCCH_ENABLE_TRACE
+#define PUCCH_TRACE_SCOPE(name)                                                                  \
+    ::pucch_f2::trace::ScopedSpan PUCCH_TRACE_CONCAT(pucch_trace_span_, __LINE__)(name)
+#define PUCCH_TRACE_THREAD_NAME(name) ::pucch_f2::trace::SetThreadName(name)
+#else
+#define PUCCH_TRACE_SCOPE(name) static_cast<void>(0)
+#define PUCCH_TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#if defined(PUCCH_ENABLE_TRACE) && PUCCH_TRACE_LEVEL >= 2
+#define PUCCH_TRACE_SCOPE_FINE(name) PUCCH_TRACE_SCOPE(name)
+#else
+#define PUCCH_TRACE_SCOPE_FINE(name) static_cast<void>(0)
+#endif
+
+#endif // PUCCH_F2_TRACE_HPP
@@ -0,0 +1,92 @@
+#!/bin/bash
+
+# Runs one channel simulation point as independent shard processes and merges the results.
+# Usage: shard_simulation.sh [shards] [code_length] [snr_db] [iterations] [verify]
+
+BINARY="./pucch_codes_modeling.elf"
+SHARDS=${1:-4}
+CODE_LENGTH=${2:-11}
+SNR_DB=${3:--4}
+ITERATIONS=${4:-20000}
+VERIFY=${5:-1}
+
+if [ ! -f "$BINARY" ]; then
+    echo "Error: Binary '$BINARY' not found. Run 'make' first."
+    exit 1
+fi
+
+TMP_DIR=$(mktemp -d)
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+echo "========================================"
+echo "  PUCCH F2 Codec — Sharded Simulation"
+echo "========================================"
+echo "Shards:       $SHARDS"
+echo "Code length:  $CODE_LENGTH bits"
+echo "SNR:          $SNR_DB dB"
+echo "Iterations:   $ITERATIONS"
+echo "========================================"
+
+PIDS=()
+for (( SHARD=0; SHARD<SHARDS; SHARD++ )); do
+    INPUT_JSON=$(cat <<JSON
+{
+    "mode": "channel simulation",
+    "num_of_pucch_f2_bits": $CODE_LENGTH,
+    "snr_db": $SNR_DB,
+    "iterations": $ITERATIONS,
+    "shard_index": $SHARD,
+    "shard_count": $SHARDS
+}
+JSON
+)
+    PUCCH_DISABLE_FILE_OUTPUT=1 $BINARY "$INPUT_JSON" > "$TMP_DIR/shard_$SHARD.json" &
+    PIDS+=($!)
+done
+
+for PID in "${PIDS[@]}"; do
+    if ! wait "$PID"; then
+        echo "Error: shard process $PID failed"
+        exit 1
+    fi
+done
+
+{
+    echo "{"
+    echo "    \"mode\": \"merge\","
+    echo "    \"shards\": ["
+    for (( SHARD=0; SHARD<SHARDS; SHARD++ )); do
+        if [ $SHARD -gt 0 ]; then
+            echo "    ,"
+        fi
+        cat "$TMP_DIR/shard_$SHARD.json"
+    done
+    echo "    ]"
+    echo "}"
+} > "$TMP_DIR/merge.json"
+
+MERGED=$(PUCCH_DISABLE_FILE_OUTPUT=1 $BINARY "$TMP_DIR/merge.json")
+if [ $? -ne 0 ]; then
+    echo "Error: merge failed"
+    echo "$MERGED"
+    exit 1
+fi
+
+echo "$MERGED"
+
+if [ "$VERIFY" -eq 1 ]; then
+    SINGLE=$(PUCCH_DISABLE_FILE_OUTPUT=1 $BINARY "{
+        \"mode\": \"channel simulation\",
+        \"num_of_pucch_f2_bits\": $CODE_LENGTH,
+        \"snr_db\": $SNR_DB,
+        \"iterations\": $ITERATIONS
+    }")
+
+    if [ "$MERGED" == "$SINGLE" ]; then
+        echo "Merged result matches single-process run"
+    else
+        echo "Error: merged result differs from single-process run"
+        echo "$SINGLE"
+        exit 1
+    fi
+fi
@@ -8,6 +8,7 @@ SNR_START=${2:--10}
 SNR_END=${3:-3}
 SNR_STEP=${4:-1}
 SKIP_PLOT=${5:-0}
+USE_CRN=${6:-0}
 
 CODE_LENGTHS=(2 4 6 8 11)
 
@@ -28,6 +29,38 @@ echo "Output:       $OUTPUT_FILE"
 echo "========================================"
 echo ""
 
+if [ "$USE_CRN" -eq 1 ]; then
+    echo ">>> Common random numbers: one run for all code lengths and SNR points"
+
+    INPUT_JSON=$(cat <<EOF
+{
+    "mode": "snr sweep",
+    "code_lengths": [$(IFS=,; echo "${CODE_LENGTHS[*]}")],
+    "snr_start": $SNR_START,
+    "snr_end": $SNR_END,
+    "snr_step": $SNR_STEP,
+    "iterations": $ITERATIONS
+}
+EOF
+)
+
+    if ! PUCCH_DISABLE_FILE_OUTPUT=1 $BINARY "$INPUT_JSON" > "$OUTPUT_FILE"; then
+        echo "FAILED"
+        exit 1
+    fi
+
+    echo "Results saved to $OUTPUT_FILE"
+
+    if [ "$SKIP_PLOT" -eq 0 ] && [ -f "$PLOT_SCRIPT" ] && command -v python3 &> /dev/null; then
+        echo "Generating plot..."
+        python3 "$PLOT_SCRIPT" "$OUTPUT_FILE"
+    fi
+
+    echo ""
+    echo "Done!"
+    exit 0
+fi
+
 ALL_RESULTS=()
 TOTAL_POINTS=$((${#CODE_LENGTHS[@]} * (($SNR_END - $SNR_START) / $SNR_STEP + 1)))
 CURRENT_POINT=0
@@ -0,0 +1,275 @@
+#include "block_code.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace pucch_f2 {
+
+namespace {
+
+// Basis sequences of the (20, A) code for PUCCH format 2; a code of length A uses the
+// rightmost A columns.
+constexpr std::array<std::array<uint8_t, 13>, 20> kPucchF2Basis = {{
+
+        {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0},
+        {1, 1, 1, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0},
+        {1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 1, 1, 1},
+        {1, 0, 1, 1, 0, 0, 0, 0, 1, 0, 1, 1, 1},
+        {1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1, 1, 1},
+        {1, 1, 0, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1},
+        {1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1},
+        {1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 1, 1, 1},
+        {1, 1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 1, 1},
+        {1, 0, 1, 1, 1, 0, 1, 0, 0, 1, 1, 1, 1},
+        {1, 0, 1, 0, 0, 1, 1, 1, 0, 1, 1, 1, 1},
+        {1, 1, 1, 0, 0, 1, 1, 0, 1, 0, 1, 1, 1},
+        {1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1},
+        {1, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1},
+        {1, 0, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1},
+        {1, 1, 0, 0, 1, 1, 1, 1, 0, 1, 1, 0, 1},
+        {1, 1, 1, 0, 1, 1, 1, 0, 0, 1, 0, 1, 1},
+        {1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 0, 1, 1},
+        {1, 1, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0},
+        {1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0}
+
+}};
+
+// Basis sequences M(i, n) of the (32, O) Reed-Muller code for UCI (36.212 Table 5.2.2.6.4-1,
+// also used by NR for 3 to 11 UCI bits); a code of size O uses the first O columns.
+constexpr std::array<std::array<uint8_t, 11>, 32> kReedMuller32Basis = {{
+
+        {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1},
+        {1, 1, 1, 0, 0, 0, 0, 0, 0, 1, 1},
+        {1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 1},
+        {1, 0, 1, 1, 0, 0, 0, 0, 1, 0, 1},
+        {1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1},
+        {1, 1, 0, 0, 1, 0, 1, 1, 1, 0, 1},
+        {1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1},
+        {1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 1},
+        {1, 1, 0, 1, 1, 0, 0, 1, 0, 1, 1},
+        {1, 0, 1, 1, 1, 0, 1, 0, 0, 1, 1},
+        {1, 0, 1, 0, 0, 1, 1, 1, 0, 1, 1},
+        {1, 1, 1, 0, 0, 1, 1, 0, 1, 0, 1},
+        {1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 1},
+        {1, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1},
+        {1, 0, 0, 0, 1, 1, 0, 1, 0, 0, 1},
+        {1, 1, 0, 0, 1, 1, 1, 1, 0, 1, 1},
+        {1, 1, 1, 0, 1, 1, 1, 0, 0, 1, 0},
+        {1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 0},
+        {1, 1, 0, 1, 1, 1, 1, 1, 0, 0, 0},
+        {1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0},
+        {1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1},
+        {1, 1, 0, 1, 0, 0, 0, 0, 0, 1, 1},
+        {1, 0, 0, 0, 1, 0, 0, 1, 1, 0, 1},
+        {1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 1},
+        {1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 0},
+        {1, 1, 0, 0, 0, 1, 1, 1, 0, 0, 1},
+        {1, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0},
+        {1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0},
+        {1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 0},
+        {1, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0},
+        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+        {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+
+}};
+
+std::string FormatDimensions(const std::vector<int>& dimensions) {
+    std::string result = "{";
+    for (std::size_t i = 0; i < dimensions.size(); ++i) {
+        result += (i > 0 ? ", " : "") + std::to_string(dimensions[i]);
+    }
+    return result + "}";
+}
+
+template <std::size_t Rows, std::size_t Cols>
+std::vector<uint32_t> SelectColumns(const std::array<std::array<uint8_t, Cols>, Rows>& basis,
+                                    int first_col, int k) {
+    std::vector<uint32_t> rows(Rows, 0);
+    for (std::size_t row = 0; row < Rows; ++row) {
+        for (int bit = 0; bit < k; ++bit) {
+            rows[row] |= static_cast<uint32_t>(basis[row][first_col + bit]) << bit;
+        }
+    }
+    return rows;
+}
+
+std::unique_ptr<BlockCode> MakeBlockCode(const std::string& name, int k) {
+    if (name == kPucchF2CodeName) {
+        return std::make_unique<BlockCode>(name, kCodewordLength, k,
+                                           SelectColumns(kPucchF2Basis, 13 - k, k));
+    }
+    return std::make_unique<BlockCode>(name, 32, k, SelectColumns(kReedMuller32Basis, 0, k));
+}
+
+} // namespace
+
+bool ValidateCodeLength(int code_length) {
+    for (int len : pucch_f2::kValidCodeLengths) {
+        if (code_length == len) {
+            return true;
+        }
+    }
+    return false;
+}
+
+BlockCode::BlockCode(std::string name, int n, int k, std::vector<uint32_t> generator_rows)
+    : name_(std::move(name)), n_(n), k_(k), generator_rows_(std::move(generator_rows)) {
+    if (n_ <= 0 || n_ > kMaxLength || k_ <= 0 || k_ > kMaxDimension || k_ > n_) {
+        throw std::invalid_argument("Invalid block code (" + std::to_string(n_) + ", " +
+                                    std::to_string(k_) + ")");
+    }
+
+    if (static_cast<int>(generator_rows_.size()) != n_) {
+        throw std::invalid_argument("Generator matrix must have " + std::to_string(n_) +
+                                    " rows, got " + std::to_string(generator_rows_.size()));
+    }
+
+    codewords_.resize(NumCodewords());
+    codeword_bits_.resize(static_cast<std::size_t>(NumCodewords()) * n_);
+    for (uint32_t message = 0; message < codewords_.size(); ++message) {
+        uint32_t codeword = 0;
+        for (int row = 0; row < n_; ++row) {
+            uint32_t bit = __builtin_popcount(generator_rows_[row] & message) & 1u;
+            codeword |= bit << row;
+            codeword_bits_[static_cast<std::size_t>(message) * n_ + row] =
+                static_cast<uint8_t>(bit);
+        }
+        codewords_[message] = codeword;
+    }
+
+    BuildParityChecks();
+}
+
+void BlockCode::BuildParityChecks() {
+    // Row-reduce the generator (one row per information bit), tracking which message each
+    // reduced row encodes.
+    std::vector<uint32_t> rows;
+    std::vector<uint32_t> messages;
+    for (int bit = 0; bit < k_; ++bit) {
+        rows.push_back(codewords_[1u << bit]);
+        messages.push_back(1u << bit);
+    }
+
+    std::size_t rank = 0;
+    for (int pos = 0; pos < n_ && rank < rows.size(); ++pos) {
+        std::size_t pivot = rank;
+        while (pivot < rows.size() && ((rows[pivot] >> pos) & 1) == 0) {
+            ++pivot;
+        }
+        if (pivot == rows.size()) {
+            continue;
+        }
+
+        std::swap(rows[rank], rows[pivot]);
+        std::swap(messages[rank], messages[pivot]);
+        for (std::size_t row = 0; row < rows.size(); ++row) {
+            if (row != rank && ((rows[row] >> pos) & 1)) {
+                rows[row] ^= rows[rank];
+                messages[row] ^= messages[rank];
+            }
+        }
+
+        information_set_.push_back(pos);
+        ++rank;
+    }
+
+    full_rank_ = static_cast<int>(rank) == k_;
+    if (!full_rank_) {
+        information_set_.clear();
+        return;
+    }
+    information_messages_ = messages;
+
+    // In reduced form a codeword is the sum of the rows whose pivot bit it has set, so every
+    // other position must equal the parity of those pivots.
+    for (int pos = 0; pos < n_; ++pos) {
+        if (std::find(information_set_.begin(), information_set_.end(), pos) !=
+            information_set_.end()) {
+            continue;
+        }
+
+        uint32_t check = 1u << pos;
+        for (std::size_t j = 0; j < rank; ++j) {
+            if ((rows[j] >> pos) & 1) {
+                check |= 1u << information_set_[j];
+            }
+        }
+        parity_checks_.push_back(check);
+    }
+}
+
+bool BlockCode::LookupMessage(uint32_t hard_decision, uint32_t& message) const {
+    if (!full_rank_) {
+        return false;
+    }
+
+    for (uint32_t check : parity_checks_) {
+        if (__builtin_popcount(hard_decision & check) & 1) {
+            return false;
+        }
+    }
+
+    message = 0;
+    for (std::size_t j = 0; j < information_set_.size(); ++j) {
+        if ((hard_decision >> information_set_[j]) & 1) {
+            message ^= information_messages_[j];
+        }
+    }
+    return true;
+}
+
+int BlockCode::MinimumDistance() const {
+    int distance = n_;
+    for (std::size_t message = 1; message < codewords_.size(); ++message) {
+        distance = std::min(distance, __builtin_popcount(codewords_[message]));
+    }
+    return distance;
+}
+
+std::vector<std::string> BlockCodeNames() {
+    return {kPucchF2CodeName, kReedMuller32CodeName};
+}
+
+std::vector<int> BlockCodeDimensions(const std::string& name) {
+    if (name == kPucchF2CodeName) {
+        return {kValidCodeLengths.begin(), kValidCodeLengths.end()};
+    }
+    if (name == kReedMuller32CodeName) {
+        return {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    }
+    throw std::invalid_argument("Unknown code: '" + name + "'. Valid codes: '" +
+                                std::string(kPucchF2CodeName) + "', '" +
+                                std::string(kReedMuller32CodeName) + "'");
+}
+
+const BlockCode& GetBlockCode(const std::string& name, int k) {
+    std::vector<int> dimensions = BlockCodeDimensions(name);
+    if (std::find(dimensions.begin(), dimensions.end(), k) == dimensions.end()) {
+        throw std::invalid_argument("Invalid k for code '" + name + "': " + std::to_string(k) +
+                                    ". Must be one of " + FormatDimensions(dimensions));
+    }
+
+    static std::mutex mutex;
+    static std::map<std::pair<std::string, int>, std::unique_ptr<BlockCode>> codes;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& code = codes[{name, k}];
+    if (!code) {
+        code = MakeBlockCode(name, k);
+    }
+    return *code;
+}
+
+const BlockCode& PucchF2Code(int code_length) {
+    if (!ValidateCodeLength(code_length)) {
+        throw std::invalid_argument("Invalid code_length: " + std::to_string(code_length) +
+                                    ". Must be one of {2, 4, 6, 8, 11} for PUCCH Format 2");
+    }
+    return GetBlockCode(kPucchF2CodeName, code_length);
+}
+
+} // namespace pucch_f2
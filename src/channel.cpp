@@ -1,16 +1,40 @@
 #include "channel.hpp"
+#include "trace.hpp"
+
+#include <random>
 
 namespace pucch_f2 {
 
-AwgnChannel::AwgnChannel(double snr_db, uint32_t seed) : random_generator_(seed) {
+AwgnChannel::AwgnChannel(double snr_db, uint32_t seed)
+    : seed_(seed), random_generator_(seed, 0, RngPurpose::kNoise), sigma_(Sigma(snr_db)) {}
+
+double AwgnChannel::Sigma(double snr_db) {
     double snr_linear = std::pow(10.0, snr_db / 10.0);
-    sigma_ = std::sqrt(1.0 / (4.0 * snr_linear));
+    return std::sqrt(1.0 / (4.0 * snr_linear));
 }
 
 std::vector<std::complex<double>>
 AwgnChannel::Transmit(const std::vector<std::complex<double>>& symbols) {
+    return Transmit(symbols, nullptr);
+}
+
+std::vector<std::complex<double>>
+AwgnChannel::Transmit(const std::vector<std::complex<double>>& symbols,
+                      std::vector<std::complex<double>>& noise) {
+    return Transmit(symbols, &noise);
+}
+
+std::vector<std::complex<double>>
+AwgnChannel::Transmit(const std::vector<std::complex<double>>& symbols,
+                      std::vector<std::complex<double>>* drawn_noise) {
+    PUCCH_TRACE_SCOPE_FINE("AwgnChannel::Transmit");
+
     std::vector<std::complex<double>> noisy_symbols;
     noisy_symbols.reserve(symbols.size());
+    if (drawn_noise != nullptr) {
+        drawn_noise->clear();
+        drawn_noise->reserve(symbols.size());
+    }
 
     std::normal_distribution<double> noise(0.0, sigma_);
 
@@ -18,9 +42,31 @@ AwgnChannel::Transmit(const std::vector<std::complex<double>>& symbols) {
         double noise_re = noise(random_generator_);
         double noise_im = noise(random_generator_);
         noisy_symbols.emplace_back(symbol.real() + noise_re, symbol.imag() + noise_im);
+        if (drawn_noise != nullptr) {
+            drawn_noise->emplace_back(noise_re, noise_im);
+        }
     }
 
     return noisy_symbols;
 }
 
+std::vector<std::complex<double>> AwgnChannel::GenerateUnitNoise(std::size_t count) {
+    std::vector<std::complex<double>> samples;
+    samples.reserve(count);
+
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        double noise_re = noise(random_generator_);
+        double noise_im = noise(random_generator_);
+        samples.emplace_back(noise_re, noise_im);
+    }
+
+    return samples;
+}
+
+void AwgnChannel::Seek(uint64_t frame) {
+    random_generator_ = FrameRng(seed_, frame, RngPurpose::kNoise);
+}
+
 } // namespace pucch_f2
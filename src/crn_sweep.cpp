@@ -0,0 +1,113 @@
+#include "crn_sweep.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace pucch_f2 {
+
+namespace {
+
+std::vector<const BlockCode*> PucchF2Codes(const std::vector<int>& code_lengths) {
+    std::vector<const BlockCode*> codes;
+    for (int code_length : code_lengths) {
+        codes.push_back(&PucchF2Code(code_length));
+    }
+    return codes;
+}
+
+} // namespace
+
+CrnSweep::CrnSweep(const std::vector<int>& code_lengths, const std::vector<double>& snr_points_db,
+                   uint32_t seed)
+    : CrnSweep(seed) {
+    Init(PucchF2Codes(code_lengths), snr_points_db);
+}
+
+CrnSweep::CrnSweep(uint32_t seed) : seed_(seed), channel_(0.0, seed) {}
+
+CrnSweep CrnSweep::ForCodes(const std::vector<const BlockCode*>& codes,
+                            const std::vector<double>& snr_points_db, uint32_t seed) {
+    CrnSweep sweep(seed);
+    sweep.Init(codes, snr_points_db);
+    return sweep;
+}
+
+void CrnSweep::Init(const std::vector<const BlockCode*>& codes,
+                    const std::vector<double>& snr_points_db) {
+    codes_ = codes;
+    snr_points_db_ = snr_points_db;
+
+    if (codes_.empty() || snr_points_db_.empty()) {
+        throw std::invalid_argument("Sweep needs at least one code length and one SNR point");
+    }
+
+    decoders_.reserve(codes_.size());
+    for (const BlockCode* code : codes_) {
+        decoders_.emplace_back(*code);
+    }
+
+    for (double snr_db : snr_points_db_) {
+        sigmas_.push_back(AwgnChannel::Sigma(snr_db));
+    }
+}
+
+std::vector<std::vector<SimulationStats>> CrnSweep::Run(const FrameRange& range) {
+    ChannelSimulator::ValidateRange(range);
+
+    std::vector<std::vector<SimulationStats>> stats(
+        codes_.size(), std::vector<SimulationStats>(snr_points_db_.size()));
+
+    int max_length = 0;
+    for (std::size_t len = 0; len < codes_.size(); ++len) {
+        for (auto& point : stats[len]) {
+            point.Resize(codes_[len]->K());
+        }
+        max_length = std::max(max_length, codes_[len]->N());
+    }
+
+    // All-zero codeword: every QPSK symbol is (1 + 1j) / sqrt(2).
+    const std::complex<double> zero_symbol = std::complex<double>(1.0, 1.0) / std::sqrt(2.0);
+    const std::size_t num_symbols = max_length / 2;
+    std::vector<std::complex<double>> received(num_symbols);
+    std::vector<double> prefix;
+
+    for (int64_t first = range.first_frame; first < range.last_frame; first += kFramesPerBatch) {
+        PUCCH_TRACE_SCOPE("crn sweep batch");
+
+        int64_t last = std::min(first + kFramesPerBatch, range.last_frame);
+
+        for (int64_t frame = first; frame < last; ++frame) {
+            channel_.Seek(frame);
+            auto noise = channel_.GenerateUnitNoise(num_symbols);
+
+            for (std::size_t snr = 0; snr < snr_points_db_.size(); ++snr) {
+                for (std::size_t i = 0; i < num_symbols; ++i) {
+                    received[i] = zero_symbol + sigmas_[snr] * noise[i];
+                }
+
+                auto llr = demodulator_.Demodulate(received, snr_points_db_[snr]);
+
+                for (std::size_t len = 0; len < decoders_.size(); ++len) {
+                    const auto* code_llr = &llr;
+                    if (codes_[len]->N() != max_length) {
+                        prefix.assign(llr.begin(), llr.begin() + codes_[len]->N());
+                        code_llr = &prefix;
+                    }
+
+                    const int64_t hits = decoders_[len].FastPathHits();
+                    uint32_t decoded =
+                        static_cast<uint32_t>(decoders_[len].DecodeIndex(*code_llr));
+                    stats[len][snr].Record(frame, 0, decoded);
+                    stats[len][snr].fast_path_hits += decoders_[len].FastPathHits() - hits;
+                }
+            }
+        }
+    }
+
+    return stats;
+}
+
+} // namespace pucch_f2
@@ -1,66 +1,105 @@
 #include "decoder.hpp"
-#include "encoder.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <stdexcept>
 #include <string>
 
 namespace pucch_f2 {
 
-Decoder::Decoder(int code_length) : code_length_(code_length), num_codewords_(1 << code_length) {
-    bool is_valid = ValidateCodeLength(code_length_);
+Decoder::Decoder(int code_length) : Decoder(PucchF2Code(code_length)) {}
 
-    if (!is_valid) {
-        throw std::invalid_argument("Invalid code_length: " + std::to_string(code_length_) +
-                                    ". Must be one of {2, 4, 6, 8, 11} for PUCCH Format 2");
-    }
+Decoder::Decoder(const BlockCode& code) : code_(&code) {}
+
+void Decoder::SetFastPathEnabled(bool enabled) {
+    fast_path_enabled_ = enabled;
+}
 
-    BuildCodewordTable();
+void Decoder::ValidateLlrSize(const std::vector<double>& llr) const {
+    if (static_cast<int>(llr.size()) != code_->N()) {
+        throw std::invalid_argument("LLR size mismatch");
+    }
 }
 
-void Decoder::BuildCodewordTable() {
-    codeword_table_.clear();
-    codeword_table_.reserve(num_codewords_);
-    Encoder encoder(code_length_);
+bool Decoder::TryFastPath(const std::vector<double>& llr, int& index) const {
+    uint32_t hard = 0;
+    double sum = 0.0;
+    double min = std::numeric_limits<double>::infinity();
 
-    for (int idx = 0; idx < num_codewords_; ++idx) {
-        std::vector<uint8_t> data(code_length_);
-        for (int i = 0; i < code_length_; ++i) {
-            data[i] = (idx >> i) & 1;
-        }
+    for (int i = 0; i < code_->N(); ++i) {
+        double reliability = std::fabs(llr[i]);
+        hard |= static_cast<uint32_t>(llr[i] < 0.0) << i;
+        sum += reliability;
+        min = std::min(min, reliability);
+    }
+
+    // Every other codeword flips at least one position of the hard decision and so loses at
+    // least 2 * min |llr| of metric; a zero or NaN LLR leaves the decision to the full search.
+    if (!(min > kReliabilityEpsilon * sum)) {
+        return false;
+    }
 
-        codeword_table_.push_back(encoder.Encode(data));
+    uint32_t message = 0;
+    if (!code_->LookupMessage(hard, message)) {
+        return false;
     }
+
+    index = static_cast<int>(message);
+    return true;
 }
 
 std::vector<uint8_t> Decoder::Decode(const std::vector<double>& llr_values) {
-    if (static_cast<int>(llr_values.size()) != kCodewordLength) {
-        throw std::invalid_argument("LLR size mismatch");
+    int best_idx = DecodeIndex(llr_values);
+
+    std::vector<uint8_t> decoded(code_->K());
+    for (int i = 0; i < code_->K(); ++i) {
+        decoded[i] = (best_idx >> i) & 1;
+    }
+
+    return decoded;
+}
+
+int Decoder::DecodeIndex(const std::vector<double>& llr_values) {
+    PUCCH_TRACE_SCOPE_FINE("Decoder::Decode");
+    ValidateLlrSize(llr_values);
+
+    ++decode_calls_;
+    int fast_index = 0;
+    if (fast_path_enabled_ && TryFastPath(llr_values, fast_index)) {
+        ++fast_path_hits_;
+        return fast_index;
     }
 
     double max_metric = -std::numeric_limits<double>::infinity();
     int best_idx = 0;
 
-    for (int idx = 0; idx < num_codewords_; ++idx) {
-        double metric = ComputeMetric(codeword_table_[idx], llr_values);
+    for (int idx = 0; idx < code_->NumCodewords(); ++idx) {
+        double metric = ComputeMetric(code_->CodewordBits(idx), llr_values);
         if (metric > max_metric) {
             max_metric = metric;
             best_idx = idx;
         }
     }
 
-    std::vector<uint8_t> decoded(code_length_);
-    for (int i = 0; i < code_length_; ++i) {
-        decoded[i] = (best_idx >> i) & 1;
+    return best_idx;
+}
+
+std::vector<double> Decoder::ComputeMetrics(const std::vector<double>& llr_values) {
+    ValidateLlrSize(llr_values);
+
+    std::vector<double> metrics(code_->NumCodewords());
+    for (int idx = 0; idx < code_->NumCodewords(); ++idx) {
+        metrics[idx] = ComputeMetric(code_->CodewordBits(idx), llr_values);
     }
 
-    return decoded;
+    return metrics;
 }
 
-double Decoder::ComputeMetric(const std::vector<uint8_t>& codeword,
-                              const std::vector<double>& llr) {
+double Decoder::ComputeMetric(const uint8_t* codeword, const std::vector<double>& llr) const {
     double metric = 0.0;
 
-    for (int i = 0; i < kCodewordLength; ++i) {
+    for (int i = 0; i < code_->N(); ++i) {
         double symbol = (codeword[i] == 0) ? 1.0 : -1.0;
         metric += symbol * llr[i];
     }
@@ -68,4 +107,4 @@ double Decoder::ComputeMetric(const std::vector<uint8_t>& codeword,
     return metric;
 }
 
-} // namespace pucch_f2
\ No newline at end of file
+} // namespace pucch_f2
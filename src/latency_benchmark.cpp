@@ -0,0 +1,160 @@
+#include "latency_benchmark.hpp"
+#include "decoder.hpp"
+#include "demodulator.hpp"
+#include "simulation.hpp"
+#include "thread_affinity.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pucch_f2 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t Nanoseconds(Clock::time_point start, Clock::time_point end) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+uint64_t MeasureClockOverhead() {
+    constexpr int kSamples = 1000;
+    uint64_t overhead = UINT64_MAX;
+    for (int i = 0; i < kSamples; ++i) {
+        auto start = Clock::now();
+        auto end = Clock::now();
+        overhead = std::min(overhead, Nanoseconds(start, end));
+    }
+    return overhead;
+}
+
+} // namespace
+
+LatencyBenchmark::LatencyBenchmark(const LatencyBenchmarkOptions& options, uint32_t seed)
+    : options_(options), seed_(seed) {
+    if (options_.iterations <= 0) {
+        throw std::invalid_argument("Iterations must be positive, got " +
+                                    std::to_string(options_.iterations));
+    }
+
+    if (options_.warmup_iterations < 0) {
+        throw std::invalid_argument("Warm-up iterations must be non-negative, got " +
+                                    std::to_string(options_.warmup_iterations));
+    }
+
+    if (options_.pin_core < -1) {
+        throw std::invalid_argument("Invalid core index " + std::to_string(options_.pin_core));
+    }
+
+    if (options_.deadline_us < 0.0) {
+        throw std::invalid_argument("Deadline must be non-negative, got " +
+                                    std::to_string(options_.deadline_us));
+    }
+
+    if (options_.load_threads < 0) {
+        throw std::invalid_argument("Number of load threads must be non-negative, got " +
+                                    std::to_string(options_.load_threads));
+    }
+}
+
+LatencyBenchmarkResult LatencyBenchmark::Run(int code_length) {
+    return Run(PucchF2Code(code_length));
+}
+
+LatencyBenchmarkResult LatencyBenchmark::Run(const BlockCode& code) {
+    LatencyBenchmarkResult result;
+    result.code_length = code.K();
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> load;
+    for (int t = 0; t < options_.load_threads; ++t) {
+        load.emplace_back([&, t] {
+            ChannelSimulator simulator(code, options_.snr_db, seed_ + 1 + t);
+            FrameBatch batch;
+            SimulationStats stats;
+            for (int64_t first = 0; !stop.load(std::memory_order_relaxed);
+                 first += kFramesPerBatch) {
+                batch.first_frame = first;
+                batch.num_frames = kFramesPerBatch;
+                simulator.GenerateBatch(batch);
+                simulator.TransmitBatch(batch);
+                simulator.DecodeBatch(batch, stats);
+            }
+        });
+    }
+
+    // The measurement runs on its own thread so that pinning does not stick to the caller.
+    std::exception_ptr error;
+    std::thread measure([&] {
+        try {
+            Measure(code, result);
+        } catch (...) {
+            error = std::current_exception();
+        }
+    });
+    measure.join();
+
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& thread : load) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return result;
+}
+
+void LatencyBenchmark::Measure(const BlockCode& code, LatencyBenchmarkResult& result) {
+    if (options_.pin_core >= 0) {
+        PinCurrentThread(options_.pin_core);
+    }
+
+    ChannelSimulator simulator(code, options_.snr_db, seed_);
+    QpskDemodulator demodulator;
+    Decoder decoder(code);
+
+    const auto deadline_ns = static_cast<uint64_t>(std::llround(options_.deadline_us * 1000.0));
+    const int64_t total = options_.warmup_iterations + options_.iterations;
+    result.clock_overhead_ns = MeasureClockOverhead();
+
+    FrameBatch batch;
+    for (int64_t first = 0; first < total; first += kFramesPerBatch) {
+        batch.first_frame = first;
+        batch.num_frames = std::min(kFramesPerBatch, total - first);
+        simulator.GenerateBatch(batch);
+        simulator.TransmitBatch(batch);
+
+        for (int64_t frame = 0; frame < batch.num_frames; ++frame) {
+            auto start = Clock::now();
+            auto llr = demodulator.Demodulate(batch.symbols[frame], options_.snr_db);
+            auto demodulated = Clock::now();
+            auto decoded = decoder.Decode(llr);
+            auto end = Clock::now();
+
+            if (first + frame < options_.warmup_iterations) {
+                continue;
+            }
+
+            const uint64_t total_ns = Nanoseconds(start, end);
+            result.decode.Record(Nanoseconds(demodulated, end));
+            result.demod_decode.Record(total_ns);
+            if (deadline_ns > 0 && total_ns > deadline_ns) {
+                ++result.deadline_misses;
+            }
+            if (decoded != batch.data[frame]) {
+                ++result.failed;
+            }
+        }
+    }
+}
+
+} // namespace pucch_f2
@@ -0,0 +1,80 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace pucch_f2 {
+
+int LatencyHistogram::BucketIndex(uint64_t value_ns) {
+    // Values below 2 * kSubBuckets are stored exactly; above that, the bucket is the octave
+    // (shift) together with the kSubBucketBits + 1 leading bits of the value.
+    if (value_ns < 2 * static_cast<uint64_t>(kSubBuckets)) {
+        return static_cast<int>(value_ns);
+    }
+    const int exponent = 63 - __builtin_clzll(value_ns);
+    const int shift = exponent - kSubBucketBits;
+    return shift * kSubBuckets + static_cast<int>(value_ns >> shift);
+}
+
+uint64_t LatencyHistogram::BucketLowerBound(int index) {
+    if (index < 2 * kSubBuckets) {
+        return static_cast<uint64_t>(index);
+    }
+    const int shift = index / kSubBuckets - 1;
+    const uint64_t mantissa = static_cast<uint64_t>(index % kSubBuckets + kSubBuckets);
+    return mantissa << shift;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(int index) {
+    if (index + 1 >= kNumBuckets) {
+        return UINT64_MAX;
+    }
+    return BucketLowerBound(index + 1) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t value_ns) {
+    ++buckets_[BucketIndex(value_ns)];
+    ++count_;
+    min_ = std::min(min_, value_ns);
+    max_ = std::max(max_, value_ns);
+    sum_ += value_ns;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+    for (int i = 0; i < kNumBuckets; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+}
+
+double LatencyHistogram::Mean() const {
+    return count_ > 0 ? static_cast<double>(sum_ / count_) : 0.0;
+}
+
+uint64_t LatencyHistogram::Percentile(double percentile) const {
+    if (percentile < 0.0 || percentile > 100.0) {
+        throw std::invalid_argument("Percentile must be in [0, 100], got " +
+                                    std::to_string(percentile));
+    }
+    if (count_ == 0) {
+        return 0;
+    }
+
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count_))));
+    uint64_t seen = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return std::clamp(BucketUpperBound(i), min_, max_);
+        }
+    }
+    return max_;
+}
+
+} // namespace pucch_f2
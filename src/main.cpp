@@ -1,9 +1,19 @@
+#include "block_code.hpp"
 #include "channel.hpp"
+#include "crn_sweep.hpp"
 #include "decoder.hpp"
 #include "demodulator.hpp"
 #include "encoder.hpp"
+#include "latency_benchmark.hpp"
 #include "modulator.hpp"
-
+#include "pipeline.hpp"
+#include "pucch_simulation.hpp"
+#include "simulation.hpp"
+#include "snr_search.hpp"
+#include "symbol_io.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iostream>
@@ -12,95 +22,129 @@
 using json = nlohmann::json;
 
 const uint32_t RANDOM_SEED = 3121113U;
+const std::size_t TOP_ERROR_CODEWORDS = 5;
 
-std::complex<double> ParseComplex(const std::string& string) {
-    double re, im;
-    char sign, j_char;
-    std::stringstream ss(string);
-
-    ss >> re >> sign;
-    ss.putback(sign);
-    ss >> im >> j_char;
-
-    return std::complex<double>(re, im);
-}
-
-std::string FormatComplex(const std::complex<double>& c) {
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(3) << c.real() << std::showpos << c.imag()
-       << std::noshowpos << "j";
+// Code of a single-code request: a "code" object {"name", "k"} or, for the PUCCH format 2
+// code, "num_of_pucch_f2_bits".
+const pucch_f2::BlockCode& ReadCode(const json& input) {
+    if (input.contains("code")) {
+        if (input.contains("num_of_pucch_f2_bits")) {
+            throw std::invalid_argument(
+                "Fields 'code' and 'num_of_pucch_f2_bits' must not be given together");
+        }
 
-    return ss.str();
-}
+        const json& code = input["code"];
+        if (!code.is_object() || !code.contains("name") || !code["name"].is_string() ||
+            !code.contains("k")) {
+            throw std::invalid_argument("Field 'code' must be an object with 'name' and 'k'");
+        }
+        return pucch_f2::GetBlockCode(code["name"].get<std::string>(), code["k"].get<int>());
+    }
 
-void ValidateCodingInput(const json& input) {
     if (!input.contains("num_of_pucch_f2_bits")) {
         throw std::invalid_argument("Missing field: 'num_of_pucch_f2_bits'");
     }
 
-    if (!input.contains("pucch_f2_bits")) {
-        throw std::invalid_argument("Missing field: 'pucch_f2_bits'");
-    }
-
     int code_length = input["num_of_pucch_f2_bits"].get<int>();
-    auto bits = input["pucch_f2_bits"].get<std::vector<uint8_t>>();
-
-    if (static_cast<int>(bits.size()) != code_length) {
-        throw std::invalid_argument("Bit count mismatch: expected " + std::to_string(code_length) +
-                                    ", got " + std::to_string(bits.size()));
-    }
-
-    for (std::size_t i = 0; i < bits.size(); ++i) {
-        if (bits[i] != 0 && bits[i] != 1) {
-            throw std::invalid_argument("Invalid bit at position " + std::to_string(i) +
-                                        ": must be 0 or 1, got " + std::to_string(bits[i]));
-        }
-    }
-
     if (!pucch_f2::ValidateCodeLength(code_length)) {
         throw std::invalid_argument("Invalid code_length: " + std::to_string(code_length) +
                                     ". Must be one of {2, 4, 6, 8, 11}");
     }
+    return pucch_f2::PucchF2Code(code_length);
 }
 
-void ValidateDecodingInput(const json& input) {
-    if (!input.contains("num_of_pucch_f2_bits")) {
-        throw std::invalid_argument("Missing field: 'num_of_pucch_f2_bits'");
+// Identifies the code in an output; PUCCH format 2 keeps its original field.
+void WriteCode(json& output, const pucch_f2::BlockCode& code) {
+    if (code.Name() == pucch_f2::kPucchF2CodeName) {
+        output["num_of_pucch_f2_bits"] = code.K();
+    } else {
+        output["code"] = {{"name", code.Name()}, {"n", code.N()}, {"k", code.K()}};
     }
+}
 
-    if (!input.contains("qpsk_symbols")) {
-        throw std::invalid_argument("Missing field: 'qpsk_symbols'");
+// Reads one frame of information bits into `bits`, reusing its storage.
+void ReadBits(const json& frame, int code_length, std::vector<uint8_t>& bits) {
+    if (!frame.is_array()) {
+        throw std::invalid_argument("Bits must be an array");
     }
 
-    int code_length = input["num_of_pucch_f2_bits"].get<int>();
-    if (!pucch_f2::ValidateCodeLength(code_length)) {
-        throw std::invalid_argument("Invalid code_length: " + std::to_string(code_length) +
-                                    ". Must be one of {2, 4, 6, 8, 11}");
+    if (static_cast<int>(frame.size()) != code_length) {
+        throw std::invalid_argument("Bit count mismatch: expected " + std::to_string(code_length) +
+                                    ", got " + std::to_string(frame.size()));
     }
 
-    auto symbols = input["qpsk_symbols"].get<std::vector<std::string>>();
+    bits.resize(code_length);
+    for (int i = 0; i < code_length; ++i) {
+        const json& bit = frame[i];
+        if (!bit.is_number_integer() || (bit.get<int64_t>() != 0 && bit.get<int64_t>() != 1)) {
+            throw std::invalid_argument("Invalid bit at position " + std::to_string(i) +
+                                        ": must be 0 or 1, got " + bit.dump());
+        }
+        bits[i] = static_cast<uint8_t>(bit.get<int>());
+    }
+}
 
-    const int expected_symbols = 10;
+// Reads one frame of QPSK symbols into `symbols`, reusing its storage.
+void ReadSymbols(const json& frame, int expected_symbols,
+                 std::vector<std::complex<double>>& symbols) {
+    if (!frame.is_array()) {
+        throw std::invalid_argument("Symbols must be an array");
+    }
 
-    if (static_cast<int>(symbols.size()) != expected_symbols) {
+    if (static_cast<int>(frame.size()) != expected_symbols) {
         throw std::invalid_argument("Symbol count mismatch: expected " +
                                     std::to_string(expected_symbols) + ", got " +
-                                    std::to_string(symbols.size()));
+                                    std::to_string(frame.size()));
     }
 
-    for (std::size_t i = 0; i < symbols.size(); ++i) {
-        const std::string& sym = symbols[i];
-        if (sym.empty() || sym.back() != 'j') {
+    symbols.resize(expected_symbols);
+    for (int i = 0; i < expected_symbols; ++i) {
+        if (!frame[i].is_string()) {
+            throw std::invalid_argument("Invalid symbol at index " + std::to_string(i) +
+                                        ": must be a string");
+        }
+        const std::string& sym = frame[i].get_ref<const std::string&>();
+        if (!pucch_f2::ParseComplex(sym, symbols[i])) {
             throw std::invalid_argument("Invalid symbol format at index " + std::to_string(i) +
                                         ": '" + sym + "' (expected format: '0.707+0.707j')");
         }
     }
 }
 
-void ValidateChannelSimulationInput(const json& input) {
-    if (!input.contains("num_of_pucch_f2_bits")) {
-        throw std::invalid_argument("Missing field: 'num_of_pucch_f2_bits'");
+// A coding or decoding request carries either one frame in `single_field` or a non-empty
+// "frames" array of them.
+void ValidateFrameFields(const json& input, const std::string& single_field) {
+    bool single = input.contains(single_field);
+    bool batched = input.contains("frames");
+
+    if (single == batched) {
+        throw std::invalid_argument("Exactly one of '" + single_field +
+                                    "' and 'frames' must be given");
+    }
+
+    if (batched && (!input["frames"].is_array() || input["frames"].empty())) {
+        throw std::invalid_argument("Field 'frames' must be a non-empty array");
     }
+}
+
+// Rethrows a frame validation error of a batched request with the frame index.
+[[noreturn]] void ThrowFrameError(std::size_t frame, const std::invalid_argument& e) {
+    throw std::invalid_argument("Frame " + std::to_string(frame) + ": " + e.what());
+}
+
+void ValidateCodingInput(const json& input) {
+    ReadCode(input);
+    ValidateFrameFields(input, "pucch_f2_bits");
+}
+
+void ValidateDecodingInput(const json& input) {
+    ReadCode(input);
+    ValidateFrameFields(input, "qpsk_symbols");
+}
+
+// Fields of a single simulated point shared by the channel and PUCCH simulation modes.
+void ValidateSimulationPointInput(const json& input) {
+    ReadCode(input);
 
     if (!input.contains("iterations")) {
         throw std::invalid_argument("Missing field: 'iterations'");
@@ -110,15 +154,9 @@ void ValidateChannelSimulationInput(const json& input) {
         throw std::invalid_argument("Missing field: 'snr_db'");
     }
 
-    int code_length = input["num_of_pucch_f2_bits"].get<int>();
-    int iterations = input["iterations"].get<int>();
+    int64_t iterations = input["iterations"].get<int64_t>();
     double snr_db = input["snr_db"].get<double>();
 
-    if (!pucch_f2::ValidateCodeLength(code_length)) {
-        throw std::invalid_argument("Invalid code_length: " + std::to_string(code_length) +
-                                    ". Must be one of {2, 4, 6, 8, 11}");
-    }
-
     if (iterations <= 0) {
         throw std::invalid_argument("iterations must be positive, got " +
                                     std::to_string(iterations));
@@ -129,109 +167,811 @@ void ValidateChannelSimulationInput(const json& input) {
     }
 }
 
-json RunCoding(const json& input) {
-    ValidateCodingInput(input);
+void ValidateChannelSimulationInput(const json& input) {
+    ValidateSimulationPointInput(input);
 
-    int code_length = input["num_of_pucch_f2_bits"].get<int>();
-    std::vector<uint8_t> data = input["pucch_f2_bits"].get<std::vector<uint8_t>>();
+    if (input.contains("shard_index") != input.contains("shard_count")) {
+        throw std::invalid_argument("Fields 'shard_index' and 'shard_count' must be given together");
+    }
+
+    if (input.contains("shard_count")) {
+        int shard_index = input["shard_index"].get<int>();
+        int shard_count = input["shard_count"].get<int>();
+
+        if (shard_count <= 0) {
+            throw std::invalid_argument("shard_count must be positive, got " +
+                                        std::to_string(shard_count));
+        }
+
+        if (shard_index < 0 || shard_index >= shard_count) {
+            throw std::invalid_argument("shard_index must be in [0, " +
+                                        std::to_string(shard_count) + "), got " +
+                                        std::to_string(shard_index));
+        }
+    }
+
+    if (input.contains("log_failed_frames") && input["log_failed_frames"].get<int64_t>() < 0) {
+        throw std::invalid_argument("log_failed_frames must be non-negative, got " +
+                                    std::to_string(input["log_failed_frames"].get<int64_t>()));
+    }
+
+    if (input.contains("pipeline") && !input["pipeline"].is_boolean()) {
+        throw std::invalid_argument("Field 'pipeline' must be a boolean");
+    }
 
-    pucch_f2::Encoder encoder(code_length);
-    auto codeword = encoder.Encode(data);
+    if (input.contains("queue_capacity") && input["queue_capacity"].get<int>() <= 0) {
+        throw std::invalid_argument("queue_capacity must be positive, got " +
+                                    std::to_string(input["queue_capacity"].get<int>()));
+    }
+
+    if (input.contains("pin_cores")) {
+        auto cores = input["pin_cores"].get<std::vector<int>>();
+        if (static_cast<int>(cores.size()) != pucch_f2::PipelineSimulator::kNumStages) {
+            throw std::invalid_argument("pin_cores must list " +
+                                        std::to_string(pucch_f2::PipelineSimulator::kNumStages) +
+                                        " cores, got " + std::to_string(cores.size()));
+        }
+    }
+}
+
+void ValidateMergeInput(const json& input) {
+    if (!input.contains("shards")) {
+        throw std::invalid_argument("Missing field: 'shards'");
+    }
+
+    const json& shards = input["shards"];
+    if (!shards.is_array() || shards.empty()) {
+        throw std::invalid_argument("Field 'shards' must be a non-empty array");
+    }
+
+    const std::string code_field = shards[0].contains("code") ? "code" : "num_of_pucch_f2_bits";
+    const std::vector<std::string> shared_fields = {code_field, "snr_db", "iterations",
+                                                    "shard_count"};
+    const std::vector<std::string> shard_fields = {"shard_index",
+                                                   "frames",
+                                                   "success",
+                                                   "failed",
+                                                   "bit_errors",
+                                                   "error_weight_histogram",
+                                                   "decoded_error_counts"};
+
+    const json& first = shards[0];
+    for (const auto& field : shared_fields) {
+        if (!first.contains(field)) {
+            throw std::invalid_argument("Shard 0: missing field '" + field + "'");
+        }
+    }
+
+    int shard_count = first["shard_count"].get<int>();
+    if (static_cast<int>(shards.size()) != shard_count) {
+        throw std::invalid_argument("Shard count mismatch: expected " +
+                                    std::to_string(shard_count) + ", got " +
+                                    std::to_string(shards.size()));
+    }
+
+    int64_t iterations = first["iterations"].get<int64_t>();
+    std::vector<bool> seen(shard_count, false);
+
+    for (std::size_t i = 0; i < shards.size(); ++i) {
+        const json& shard = shards[i];
+        const std::string prefix = "Shard " + std::to_string(i) + ": ";
+
+        for (const auto& field : shared_fields) {
+            if (!shard.contains(field) || shard[field] != first[field]) {
+                throw std::invalid_argument(prefix + "field '" + field +
+                                            "' is missing or differs from shard 0");
+            }
+        }
+
+        for (const auto& field : shard_fields) {
+            if (!shard.contains(field)) {
+                throw std::invalid_argument(prefix + "missing field '" + field + "'");
+            }
+        }
+
+        int shard_index = shard["shard_index"].get<int>();
+        if (shard_index < 0 || shard_index >= shard_count || seen[shard_index]) {
+            throw std::invalid_argument(prefix + "invalid or duplicate shard_index " +
+                                        std::to_string(shard_index));
+        }
+        seen[shard_index] = true;
+
+        pucch_f2::FrameRange range =
+            pucch_f2::ComputeShardRange(iterations, shard_index, shard_count);
+        int64_t frames = shard["frames"].get<int64_t>();
+        int64_t success = shard["success"].get<int64_t>();
+        int64_t failed = shard["failed"].get<int64_t>();
+
+        if (frames != range.last_frame - range.first_frame || success < 0 || failed < 0 ||
+            success + failed != frames) {
+            throw std::invalid_argument(prefix + "frame counts are inconsistent with shard " +
+                                        std::to_string(shard_index) + " of " +
+                                        std::to_string(shard_count));
+        }
+
+        int code_length = ReadCode(shard).K();
+        if (shard["bit_errors"].size() != static_cast<std::size_t>(code_length) ||
+            shard["error_weight_histogram"].size() != static_cast<std::size_t>(code_length) + 1) {
+            throw std::invalid_argument(prefix + "bit error statistics do not match " +
+                                        std::to_string(code_length) + " information bits");
+        }
+
+        if (shard.contains("failed_frames") != shard.contains("log_failed_frames")) {
+            throw std::invalid_argument(prefix + "'failed_frames' and 'log_failed_frames' must be "
+                                                 "given together");
+        }
+
+        for (const json& entry : shard["decoded_error_counts"]) {
+            if (!entry.is_array() || entry.size() != 2 || entry[0].get<int64_t>() < 0 ||
+                entry[0].get<int64_t>() >= (int64_t{1} << code_length)) {
+                throw std::invalid_argument(prefix + "invalid decoded_error_counts entry " +
+                                            entry.dump());
+            }
+        }
+    }
+}
+
+// Codes of a multi-code request: a "code" object (every registered k when "k" is omitted),
+// PUCCH format 2 "code_lengths" or "num_of_pucch_f2_bits", or all PUCCH format 2 lengths.
+std::vector<const pucch_f2::BlockCode*> ReadCodes(const json& input) {
+    std::vector<const pucch_f2::BlockCode*> codes;
+
+    if (input.contains("code") && input["code"].is_object() && !input["code"].contains("k")) {
+        if (!input["code"].contains("name") || !input["code"]["name"].is_string()) {
+            throw std::invalid_argument("Field 'code' must be an object with 'name' and 'k'");
+        }
 
+        std::string name = input["code"]["name"].get<std::string>();
+        for (int k : pucch_f2::BlockCodeDimensions(name)) {
+            codes.push_back(&pucch_f2::GetBlockCode(name, k));
+        }
+        return codes;
+    }
+
+    if (input.contains("code") || (input.contains("num_of_pucch_f2_bits") &&
+                                   !input.contains("code_lengths"))) {
+        codes.push_back(&ReadCode(input));
+        return codes;
+    }
+
+    std::vector<int> code_lengths;
+    if (input.contains("code_lengths")) {
+        code_lengths = input["code_lengths"].get<std::vector<int>>();
+    } else {
+        code_lengths.assign(pucch_f2::kValidCodeLengths.begin(), pucch_f2::kValidCodeLengths.end());
+    }
+
+    if (code_lengths.empty()) {
+        throw std::invalid_argument("Field 'code_lengths' must not be empty");
+    }
+
+    for (int code_length : code_lengths) {
+        if (!pucch_f2::ValidateCodeLength(code_length)) {
+            throw std::invalid_argument("Invalid code_length: " + std::to_string(code_length) +
+                                        ". Must be one of {2, 4, 6, 8, 11}");
+        }
+        codes.push_back(&pucch_f2::PucchF2Code(code_length));
+    }
+
+    return codes;
+}
+
+json RunCoding(const json& input) {
+    PUCCH_TRACE_SCOPE("coding");
+    ValidateCodingInput(input);
+
+    const pucch_f2::BlockCode& code = ReadCode(input);
+    pucch_f2::Encoder encoder(code);
     pucch_f2::QpskModulator modulator;
-    auto symbols = modulator.Modulate(codeword);
+
+    std::vector<uint8_t> data;
+    auto encode = [&]() {
+        json::array_t symbols_str;
+        symbols_str.reserve(code.N() / 2);
+        for (const auto& sym : modulator.Modulate(encoder.Encode(data))) {
+            symbols_str.emplace_back(pucch_f2::FormatComplex(sym));
+        }
+        return symbols_str;
+    };
 
     json output;
     output["mode"] = "coding";
-    output["num_of_pucch_f2_bits"] = code_length;
+    WriteCode(output, code);
+
+    if (!input.contains("frames")) {
+        ReadBits(input["pucch_f2_bits"], code.K(), data);
+        output["qpsk_symbols"] = encode();
+        return output;
+    }
 
-    std::vector<std::string> symbols_str;
-    for (const auto& sym : symbols) {
-        symbols_str.push_back(FormatComplex(sym));
+    const json& frames = input["frames"];
+    json::array_t frames_out;
+    frames_out.reserve(frames.size());
+    for (std::size_t f = 0; f < frames.size(); ++f) {
+        try {
+            ReadBits(frames[f], code.K(), data);
+        } catch (const std::invalid_argument& e) {
+            ThrowFrameError(f, e);
+        }
+        frames_out.emplace_back(encode());
     }
-    output["qpsk_symbols"] = symbols_str;
+    output["frames"] = std::move(frames_out);
 
     return output;
 }
 
 json RunDecoding(const json& input) {
+    PUCCH_TRACE_SCOPE("decoding");
     ValidateDecodingInput(input);
 
-    int code_length = input["num_of_pucch_f2_bits"].get<int>();
-    std::vector<std::string> symbols_str = input["qpsk_symbols"].get<std::vector<std::string>>();
+    const pucch_f2::BlockCode& code = ReadCode(input);
+    pucch_f2::QpskDemodulator demodulator;
+    pucch_f2::Decoder decoder(code);
 
     std::vector<std::complex<double>> symbols;
-    symbols.reserve(symbols_str.size());
-    for (const auto& str : symbols_str) {
-        symbols.push_back(ParseComplex(str));
+    auto decode = [&]() { return decoder.Decode(demodulator.Demodulate(symbols, 100.0)); };
+
+    json output;
+    output["mode"] = "decoding";
+    WriteCode(output, code);
+
+    if (!input.contains("frames")) {
+        ReadSymbols(input["qpsk_symbols"], code.N() / 2, symbols);
+        output["pucch_f2_bits"] = decode();
+        return output;
     }
 
-    pucch_f2::QpskDemodulator demodulator;
-    auto llr = demodulator.Demodulate(symbols, 100.0);
+    const json& frames = input["frames"];
+    json::array_t frames_out;
+    frames_out.reserve(frames.size());
+    for (std::size_t f = 0; f < frames.size(); ++f) {
+        try {
+            ReadSymbols(frames[f], code.N() / 2, symbols);
+        } catch (const std::invalid_argument& e) {
+            ThrowFrameError(f, e);
+        }
+        frames_out.emplace_back(decode());
+    }
+    output["frames"] = std::move(frames_out);
+
+    return output;
+}
 
-    pucch_f2::Decoder decoder(code_length);
-    auto decoded = decoder.Decode(llr);
+json FormatSimulationOutput(const pucch_f2::BlockCode& code, double snr_db, int64_t iterations,
+                            const pucch_f2::SimulationStats& stats) {
+    auto [ci_low, ci_high] = pucch_f2::WilsonInterval(stats.failed, stats.frames);
 
     json output;
-    output["mode"] = "decoding";
-    output["num_of_pucch_f2_bits"] = code_length;
-    output["pucch_f2_bits"] = decoded;
+    output["mode"] = "channel simulation";
+    WriteCode(output, code);
+    output["snr_db"] = snr_db;
+    output["iterations"] = iterations;
+    output["bler"] = stats.frames > 0 ? static_cast<double>(stats.failed) / stats.frames : 0.0;
+    output["bler_ci_low"] = ci_low;
+    output["bler_ci_high"] = ci_high;
+    output["success"] = stats.success;
+    output["failed"] = stats.failed;
+    output["fast_path_hits"] = stats.fast_path_hits;
+    output["fast_path_hit_rate"] =
+        stats.frames > 0 ? static_cast<double>(stats.fast_path_hits) / stats.frames : 0.0;
+
+    int64_t info_bits = stats.frames * code.K();
+    output["ber"] =
+        info_bits > 0 ? static_cast<double>(stats.TotalBitErrors()) / info_bits : 0.0;
+    output["bit_errors"] = stats.bit_errors;
+
+    std::vector<double> bit_error_rates;
+    for (int64_t errors : stats.bit_errors) {
+        bit_error_rates.push_back(
+            stats.frames > 0 ? static_cast<double>(errors) / stats.frames : 0.0);
+    }
+    output["bit_error_rates"] = bit_error_rates;
+    output["error_weight_histogram"] = stats.error_weights;
+
+    std::vector<std::size_t> indices;
+    for (std::size_t idx = 0; idx < stats.decoded_errors.size(); ++idx) {
+        if (stats.decoded_errors[idx] > 0) {
+            indices.push_back(idx);
+        }
+    }
+    std::stable_sort(indices.begin(), indices.end(), [&](std::size_t a, std::size_t b) {
+        return stats.decoded_errors[a] > stats.decoded_errors[b];
+    });
+    indices.resize(std::min(indices.size(), TOP_ERROR_CODEWORDS));
+
+    json top_error_codewords = json::array();
+    for (std::size_t idx : indices) {
+        top_error_codewords.push_back({{"index", idx}, {"count", stats.decoded_errors[idx]}});
+    }
+    output["top_error_codewords"] = top_error_codewords;
+
+    if (stats.failed_frames_limit > 0) {
+        output["log_failed_frames"] = stats.failed_frames_limit;
+        output["failed_frames"] = stats.failed_frames;
+    }
+
+    return output;
+}
+
+json FormatDecodedErrorCounts(const pucch_f2::SimulationStats& stats) {
+    json counts = json::array();
+    for (std::size_t idx = 0; idx < stats.decoded_errors.size(); ++idx) {
+        if (stats.decoded_errors[idx] > 0) {
+            counts.push_back({idx, stats.decoded_errors[idx]});
+        }
+    }
+
+    return counts;
+}
+
+json FormatPipelineStats(const pucch_f2::PipelineStats& stats) {
+    json stages = json::array();
+    for (const auto& stage : stats.stages) {
+        stages.push_back({{"name", stage.name},
+                          {"batches", stage.batches},
+                          {"busy_seconds", stage.busy_seconds},
+                          {"utilization", stats.wall_seconds > 0.0
+                                              ? stage.busy_seconds / stats.wall_seconds
+                                              : 0.0},
+                          {"starved_waits", stage.starved_waits}});
+    }
+
+    json queues = json::array();
+    for (const auto& queue : stats.queues) {
+        queues.push_back({{"name", queue.name},
+                          {"capacity", queue.capacity},
+                          {"mean_occupancy", queue.mean_occupancy},
+                          {"max_occupancy", queue.max_occupancy},
+                          {"full_waits", queue.full_waits}});
+    }
+
+    json output;
+    output["wall_seconds"] = stats.wall_seconds;
+    output["stages"] = stages;
+    output["queues"] = queues;
 
     return output;
 }
 
 json RunChannelSimulation(const json& input) {
+    PUCCH_TRACE_SCOPE("channel simulation");
     ValidateChannelSimulationInput(input);
 
-    int code_length = input["num_of_pucch_f2_bits"].get<int>();
-    int iterations = input["iterations"].get<int>();
+    const pucch_f2::BlockCode& code = ReadCode(input);
+    int64_t iterations = input["iterations"].get<int64_t>();
     double snr_db = input["snr_db"].get<double>();
 
-    pucch_f2::Encoder encoder(code_length);
-    pucch_f2::QpskModulator modulator;
-    pucch_f2::AwgnChannel channel(snr_db, RANDOM_SEED);
-    pucch_f2::QpskDemodulator demodulator;
-    pucch_f2::Decoder decoder(code_length);
+    int shard_index = input.value("shard_index", 0);
+    int shard_count = input.value("shard_count", 1);
+    pucch_f2::FrameRange range = pucch_f2::ComputeShardRange(iterations, shard_index, shard_count);
+
+    json pipeline_output;
+    pucch_f2::SimulationStats stats;
+    std::size_t failed_frames_limit = input.value("log_failed_frames", std::size_t{0});
+
+    if (input.value("pipeline", false)) {
+        pucch_f2::PipelineOptions options;
+        options.queue_capacity = input.value("queue_capacity", 4);
+        options.pin_cores = input.value("pin_cores", std::vector<int>());
+
+        pucch_f2::PipelineSimulator simulator(code, snr_db, RANDOM_SEED, options);
+        simulator.SetFailedFramesLimit(failed_frames_limit);
+        stats = simulator.Run(range);
+        pipeline_output = FormatPipelineStats(simulator.Stats());
+    } else {
+        pucch_f2::ChannelSimulator simulator(code, snr_db, RANDOM_SEED);
+        simulator.SetFailedFramesLimit(failed_frames_limit);
+        stats = simulator.Run(range);
+    }
 
-    std::mt19937 rng(RANDOM_SEED);
-    std::uniform_int_distribution<int> bit_dist(0, 1);
+    json output = FormatSimulationOutput(code, snr_db, iterations, stats);
 
-    int success_count = 0;
-    int failed_count = 0;
+    if (!pipeline_output.is_null()) {
+        output["pipeline"] = pipeline_output;
+    }
 
-    for (int iter = 0; iter < iterations; ++iter) {
-        std::vector<uint8_t> data(code_length);
-        for (int i = 0; i < code_length; ++i) {
-            data[i] = static_cast<uint8_t>(bit_dist(rng));
+    if (input.contains("shard_count")) {
+        output["shard_index"] = shard_index;
+        output["shard_count"] = shard_count;
+        output["first_frame"] = range.first_frame;
+        output["frames"] = stats.frames;
+        output["decoded_error_counts"] = FormatDecodedErrorCounts(stats);
+    }
+
+    return output;
+}
+
+json RunMerge(const json& input) {
+    ValidateMergeInput(input);
+
+    const json& shards = input["shards"];
+    const pucch_f2::BlockCode& code = ReadCode(shards[0]);
+    const int code_length = code.K();
+    int64_t iterations = shards[0]["iterations"].get<int64_t>();
+    double snr_db = shards[0]["snr_db"].get<double>();
+
+    pucch_f2::SimulationStats stats;
+    stats.Resize(code_length);
+
+    for (const json& shard : shards) {
+        pucch_f2::SimulationStats shard_stats;
+        shard_stats.frames = shard["frames"].get<int64_t>();
+        shard_stats.success = shard["success"].get<int64_t>();
+        shard_stats.failed = shard["failed"].get<int64_t>();
+        // Absent in shards written before the decoder fast path existed.
+        shard_stats.fast_path_hits = shard.value("fast_path_hits", int64_t{0});
+        shard_stats.bit_errors = shard["bit_errors"].get<std::vector<int64_t>>();
+        shard_stats.error_weights = shard["error_weight_histogram"].get<std::vector<int64_t>>();
+
+        shard_stats.Resize(code_length);
+        for (const json& entry : shard["decoded_error_counts"]) {
+            shard_stats.decoded_errors[entry[0].get<std::size_t>()] = entry[1].get<int64_t>();
         }
 
-        auto codeword = encoder.Encode(data);
-        auto symbols = modulator.Modulate(codeword);
-        auto received = channel.Transmit(symbols);
-        auto llr = demodulator.Demodulate(received, snr_db);
-        auto decoded = decoder.Decode(llr);
+        if (shard.contains("failed_frames")) {
+            shard_stats.failed_frames_limit = shard["log_failed_frames"].get<std::size_t>();
+            shard_stats.failed_frames = shard["failed_frames"].get<std::vector<int64_t>>();
+        }
 
-        if (data == decoded) {
-            ++success_count;
-        } else {
-            ++failed_count;
+        stats.Merge(shard_stats);
+    }
+
+    return FormatSimulationOutput(code, snr_db, iterations, stats);
+}
+
+void ValidateReplayInput(const json& input) {
+    ReadCode(input);
+
+    for (const char* field : {"snr_db", "frame"}) {
+        if (!input.contains(field)) {
+            throw std::invalid_argument("Missing field: '" + std::string(field) + "'");
         }
     }
 
-    double bler = static_cast<double>(failed_count) / iterations;
+    if (input["frame"].get<int64_t>() < 0) {
+        throw std::invalid_argument("frame must be non-negative, got " +
+                                    std::to_string(input["frame"].get<int64_t>()));
+    }
+}
+
+json RunReplay(const json& input) {
+    ValidateReplayInput(input);
+
+    const pucch_f2::BlockCode& code = ReadCode(input);
+    const int code_length = code.K();
+    double snr_db = input["snr_db"].get<double>();
+    int64_t frame = input["frame"].get<int64_t>();
+
+    pucch_f2::ChannelSimulator simulator(code, snr_db, RANDOM_SEED);
+    pucch_f2::FrameTrace trace = simulator.ReplayFrame(frame);
+
+    auto format_symbols = [](const std::vector<std::complex<double>>& symbols) {
+        std::vector<std::string> formatted;
+        for (const auto& sym : symbols) {
+            formatted.push_back(pucch_f2::FormatComplex(sym));
+        }
+        return formatted;
+    };
+
+    std::vector<uint8_t> decoded(code_length);
+    for (int i = 0; i < code_length; ++i) {
+        decoded[i] = (trace.decoded_index >> i) & 1;
+    }
 
     json output;
-    output["mode"] = "channel simulation";
-    output["num_of_pucch_f2_bits"] = code_length;
+    output["mode"] = "replay";
+    WriteCode(output, code);
     output["snr_db"] = snr_db;
-    output["iterations"] = iterations;
-    output["bler"] = bler;
-    output["success"] = success_count;
-    output["failed"] = failed_count;
+    output["frame"] = frame;
+    output["pucch_f2_bits"] = trace.data;
+    output["codeword"] = trace.codeword;
+    output["qpsk_symbols"] = format_symbols(trace.symbols);
+    output["noise"] = format_symbols(trace.noise);
+    output["received_symbols"] = format_symbols(trace.received);
+    output["llr"] = trace.llr;
+    output["metrics"] = trace.metrics;
+    output["sent_index"] = trace.sent_index;
+    output["sent_metric"] = trace.metrics[trace.sent_index];
+    output["decoded_index"] = trace.decoded_index;
+    output["decoded_metric"] = trace.metrics[trace.decoded_index];
+    output["decoded_bits"] = decoded;
+    output["success"] = trace.sent_index == trace.decoded_index;
+
+    return output;
+}
+
+json RunSnrSearch(const json& input) {
+    PUCCH_TRACE_SCOPE("snr search");
+
+    std::vector<const pucch_f2::BlockCode*> codes = ReadCodes(input);
+
+    pucch_f2::SnrSearchOptions options;
+    options.target_bler = input.value("target_bler", options.target_bler);
+    options.snr_low_db = input.value("snr_low_db", options.snr_low_db);
+    options.snr_high_db = input.value("snr_high_db", options.snr_high_db);
+    options.tolerance_db = input.value("tolerance_db", options.tolerance_db);
+    options.min_iterations = input.value("min_iterations", options.min_iterations);
+    options.max_iterations = input.value("max_iterations", options.max_iterations);
+    options.z = input.value("confidence_z", options.z);
+
+    pucch_f2::SnrSearch search(options, RANDOM_SEED);
+
+    json results = json::array();
+    int64_t total_frames = 0;
+
+    for (const pucch_f2::BlockCode* code : codes) {
+        pucch_f2::SnrSearchResult result = search.Run(*code);
+        total_frames += result.total_frames;
+
+        json probes = json::array();
+        for (const auto& probe : result.probes) {
+            probes.push_back({{"snr_db", probe.snr_db},
+                              {"iterations", probe.frames},
+                              {"bler", probe.Bler()},
+                              {"bler_ci_low", probe.bler_ci_low},
+                              {"bler_ci_high", probe.bler_ci_high},
+                              {"resolved", probe.resolved},
+                              {"at_target", probe.at_target}});
+        }
+
+        json entry = {{"required_snr_db", result.required_snr_db},
+                      {"snr_low_db", result.snr_low_db},
+                      {"snr_high_db", result.snr_high_db},
+                      {"resolved", result.resolved},
+                      {"frames", result.total_frames},
+                      {"probes", probes}};
+        WriteCode(entry, *code);
+        results.push_back(entry);
+    }
+
+    json output;
+    output["mode"] = "snr search";
+    output["target_bler"] = options.target_bler;
+    output["tolerance_db"] = options.tolerance_db;
+    output["confidence_z"] = options.z;
+    output["total_frames"] = total_frames;
+    output["results"] = results;
+
+    return output;
+}
+
+void ValidateSnrSweepInput(const json& input) {
+    for (const char* field : {"snr_start", "snr_end", "snr_step", "iterations"}) {
+        if (!input.contains(field)) {
+            throw std::invalid_argument("Missing field: '" + std::string(field) + "'");
+        }
+    }
+
+    double snr_start = input["snr_start"].get<double>();
+    double snr_end = input["snr_end"].get<double>();
+    double snr_step = input["snr_step"].get<double>();
+    int64_t iterations = input["iterations"].get<int64_t>();
+
+    if (snr_step <= 0.0) {
+        throw std::invalid_argument("snr_step must be positive, got " + std::to_string(snr_step));
+    }
+
+    if (snr_end < snr_start) {
+        throw std::invalid_argument("snr_end must not be below snr_start");
+    }
+
+    if (iterations <= 0) {
+        throw std::invalid_argument("iterations must be positive, got " +
+                                    std::to_string(iterations));
+    }
+}
+
+json RunSnrSweep(const json& input) {
+    PUCCH_TRACE_SCOPE("snr sweep");
+
+    ValidateSnrSweepInput(input);
+    std::vector<const pucch_f2::BlockCode*> codes = ReadCodes(input);
+
+    double snr_start = input["snr_start"].get<double>();
+    double snr_end = input["snr_end"].get<double>();
+    double snr_step = input["snr_step"].get<double>();
+    int64_t iterations = input["iterations"].get<int64_t>();
+
+    std::vector<double> snr_points;
+    for (int point = 0; snr_start + point * snr_step <= snr_end + 1e-9; ++point) {
+        snr_points.push_back(snr_start + point * snr_step);
+    }
+
+    auto sweep = pucch_f2::CrnSweep::ForCodes(codes, snr_points, RANDOM_SEED);
+    auto stats = sweep.Run({0, iterations});
+
+    json results = json::array();
+    std::vector<int> code_lengths;
+    for (std::size_t len = 0; len < codes.size(); ++len) {
+        code_lengths.push_back(codes[len]->K());
+        for (std::size_t snr = 0; snr < snr_points.size(); ++snr) {
+            results.push_back(FormatSimulationOutput(*codes[len], snr_points[snr], iterations,
+                                                     stats[len][snr]));
+        }
+    }
+
+    json output;
+    output["mode"] = "snr sweep";
+    output["metadata"] = {{"code_lengths", code_lengths},
+                          {"snr_range", {{"start", snr_start}, {"end", snr_end}, {"step", snr_step}}},
+                          {"iterations", iterations},
+                          {"common_random_numbers", true}};
+    output["results"] = results;
 
     return output;
 }
 
+void ValidatePucchSimulationInput(const json& input) {
+    ValidateSimulationPointInput(input);
+
+    for (const char* field : {"shard_index", "shard_count", "log_failed_frames", "pipeline",
+                              "queue_capacity", "pin_cores"}) {
+        if (input.contains(field)) {
+            throw std::invalid_argument("Field '" + std::string(field) +
+                                        "' is not supported in mode 'pucch simulation'");
+        }
+    }
+
+    if (input.contains("num_ues")) {
+        int num_ues = input["num_ues"].get<int>();
+        if (num_ues < 1 || num_ues > pucch_f2::kNumCyclicShifts) {
+            throw std::invalid_argument("num_ues must be in [1, " +
+                                        std::to_string(pucch_f2::kNumCyclicShifts) + "], got " +
+                                        std::to_string(num_ues));
+        }
+    }
+
+    if (input.contains("channel") && !input["channel"].is_string()) {
+        throw std::invalid_argument("Field 'channel' must be a string");
+    }
+}
+
+json RunPucchSimulation(const json& input) {
+    PUCCH_TRACE_SCOPE("pucch simulation");
+    ValidatePucchSimulationInput(input);
+
+    const pucch_f2::BlockCode& code = ReadCode(input);
+    int64_t iterations = input["iterations"].get<int64_t>();
+    double snr_db = input["snr_db"].get<double>();
+    int num_ues = input.value("num_ues", pucch_f2::kNumCyclicShifts);
+    std::string channel = input.value("channel", std::string("awgn"));
+
+    pucch_f2::PucchSimulator simulator(code, snr_db, num_ues,
+                                       pucch_f2::ParseFadingModel(channel), RANDOM_SEED);
+
+    auto start = std::chrono::steady_clock::now();
+    pucch_f2::PucchSimulationResult result = simulator.Run({0, iterations});
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    json output = FormatSimulationOutput(code, snr_db, iterations, result.stats);
+    output["mode"] = "pucch simulation";
+    output["channel"] = channel;
+    output["num_ues"] = num_ues;
+    output["frames"] = result.stats.frames;
+
+    json ues = json::array();
+    for (int ue = 0; ue < num_ues; ++ue) {
+        ues.push_back({{"cyclic_shift", pucch_f2::PucchSimulator::CyclicShift(ue, num_ues)},
+                       {"failed", result.failed_per_ue[ue]},
+                       {"bler", static_cast<double>(result.failed_per_ue[ue]) / iterations}});
+    }
+    output["ues"] = ues;
+    output["channel_estimation_mse"] = result.channel_estimation_mse;
+    output["subframes_per_second"] = seconds > 0.0 ? iterations / seconds : 0.0;
+
+    return output;
+}
+
+json FormatLatencyHistogram(const pucch_f2::LatencyHistogram& histogram) {
+    return {{"count", histogram.Count()},
+            {"mean_ns", histogram.Mean()},
+            {"min_ns", histogram.Min()},
+            {"p50_ns", histogram.Percentile(50.0)},
+            {"p90_ns", histogram.Percentile(90.0)},
+            {"p99_ns", histogram.Percentile(99.0)},
+            {"p99_9_ns", histogram.Percentile(99.9)},
+            {"max_ns", histogram.Max()}};
+}
+
+json RunLatencyBenchmark(const json& input) {
+    std::vector<const pucch_f2::BlockCode*> codes = ReadCodes(input);
+
+    pucch_f2::LatencyBenchmarkOptions options;
+    options.snr_db = input.value("snr_db", options.snr_db);
+    options.iterations = input.value("iterations", options.iterations);
+    options.warmup_iterations = input.value("warmup_iterations", options.warmup_iterations);
+    options.pin_core = input.value("pin_core", options.pin_core);
+    options.deadline_us = input.value("deadline_us", options.deadline_us);
+    options.load_threads = input.value("load_threads", options.load_threads);
+
+    pucch_f2::LatencyBenchmark benchmark(options, RANDOM_SEED);
+
+    json results = json::array();
+    for (const pucch_f2::BlockCode* code : codes) {
+        pucch_f2::LatencyBenchmarkResult result = benchmark.Run(*code);
+
+        json entry = {{"iterations", result.decode.Count()},
+                      {"failed", result.failed},
+                      {"clock_overhead_ns", result.clock_overhead_ns},
+                      {"decode", FormatLatencyHistogram(result.decode)},
+                      {"demod_decode", FormatLatencyHistogram(result.demod_decode)}};
+        WriteCode(entry, *code);
+        if (options.deadline_us > 0.0) {
+            entry["deadline_misses"] = result.deadline_misses;
+            entry["deadline_miss_rate"] =
+                static_cast<double>(result.deadline_misses) / result.demod_decode.Count();
+        }
+        results.push_back(entry);
+    }
+
+    json output;
+    output["mode"] = "latency benchmark";
+    output["metadata"] = {{"snr_db", options.snr_db},
+                          {"iterations", options.iterations},
+                          {"warmup_iterations", options.warmup_iterations},
+                          {"pin_core", options.pin_core},
+                          {"deadline_us", options.deadline_us},
+                          {"load_threads", options.load_threads}};
+    output["results"] = results;
+
+    return output;
+}
+
+std::string ReadTraceFile(const json& input) {
+    if (!input.contains("trace_file")) {
+        return "";
+    }
+
+    if (!input["trace_file"].is_string() || input["trace_file"].get<std::string>().empty()) {
+        throw std::invalid_argument("Field 'trace_file' must be a non-empty string");
+    }
+
+    if (!pucch_f2::trace::IsCompiledIn()) {
+        std::cerr << "Warning: tracing is compiled out, rebuild with 'make TRACE=1' to record "
+                     "'trace_file'\n";
+        return "";
+    }
+
+    return input["trace_file"].get<std::string>();
+}
+
+// Path of the result file: "result_file" if given, "result.json" by default. Empty when
+// disabled by "result_file": false or by the PUCCH_DISABLE_FILE_OUTPUT environment variable.
+std::string ReadResultFile(const json& input) {
+    std::string path = "result.json";
+
+    if (input.contains("result_file")) {
+        const json& field = input["result_file"];
+        if (field.is_boolean() && !field.get<bool>()) {
+            path.clear();
+        } else if (field.is_string() && !field.get<std::string>().empty()) {
+            path = field.get<std::string>();
+        } else {
+            throw std::invalid_argument("Field 'result_file' must be a non-empty string or false");
+        }
+    }
+
+    if (std::getenv("PUCCH_DISABLE_FILE_OUTPUT") != nullptr) {
+        path.clear();
+    }
+
+    return path;
+}
+
+// Indentation of the output JSON: 4 spaces, or a single line with "compact": true.
+int ReadOutputIndent(const json& input) {
+    if (!input.contains("compact")) {
+        return 4;
+    }
+
+    if (!input["compact"].is_boolean()) {
+        throw std::invalid_argument("Field 'compact' must be a boolean");
+    }
+
+    return input["compact"].get<bool>() ? -1 : 4;
+}
+
 std::string ReadJsonInput(int argc, char* argv[]) {
     if (argc < 2) {
         throw std::invalid_argument("Not enough command line arguments");
@@ -273,6 +1013,14 @@ int main(int argc, char* argv[]) {
         }
         std::string mode = input["mode"].get<std::string>();
 
+        std::string trace_file = ReadTraceFile(input);
+        if (!trace_file.empty()) {
+            pucch_f2::trace::Enable();
+        }
+
+        std::string result_file_path = ReadResultFile(input);
+        int indent = ReadOutputIndent(input);
+
         json output;
         if (mode == "coding") {
             output = RunCoding(input);
@@ -280,27 +1028,50 @@ int main(int argc, char* argv[]) {
             output = RunDecoding(input);
         } else if (mode == "channel simulation") {
             output = RunChannelSimulation(input);
+        } else if (mode == "merge") {
+            output = RunMerge(input);
+        } else if (mode == "snr search") {
+            output = RunSnrSearch(input);
+        } else if (mode == "snr sweep") {
+            output = RunSnrSweep(input);
+        } else if (mode == "replay") {
+            output = RunReplay(input);
+        } else if (mode == "latency benchmark") {
+            output = RunLatencyBenchmark(input);
+        } else if (mode == "pucch simulation") {
+            output = RunPucchSimulation(input);
         } else {
             throw std::invalid_argument(
                 "Unknown mode: '" + mode +
-                "'. Valid modes: 'coding', 'decoding', 'channel simulation'");
+                "'. Valid modes: 'coding', 'decoding', 'channel simulation', 'merge', "
+                "'snr search', 'snr sweep', 'replay', 'latency benchmark', "
+                "'pucch simulation'");
+        }
+
+        if (!trace_file.empty()) {
+            pucch_f2::trace::WriteChromeTrace(trace_file);
+            if (pucch_f2::trace::DroppedEventCount() > 0) {
+                std::cerr << "Warning: " << pucch_f2::trace::DroppedEventCount()
+                          << " spans were dropped after " << pucch_f2::trace::kMaxEventsPerThread
+                          << " per thread\n";
+            }
         }
 
-        std::string output_str = output.dump(4);
+        std::string output_str = output.dump(indent);
 
         std::cout << output_str << std::endl;
 
-        const char* disable_file = std::getenv("PUCCH_DISABLE_FILE_OUTPUT");
-        if (disable_file == nullptr) {
+        if (!result_file_path.empty()) {
             try {
-                std::ofstream result_file("result.json");
+                std::ofstream result_file(result_file_path);
                 if (!result_file.is_open()) {
-                    throw std::runtime_error("Cannot create result.json");
+                    throw std::runtime_error("Cannot create " + result_file_path);
                 }
                 result_file << output_str << std::endl;
                 result_file.close();
             } catch (const std::exception& e) {
-                std::cerr << "Failed to write result.json: " << e.what() << std::endl;
+                std::cerr << "Failed to write " << result_file_path << ": " << e.what()
+                          << std::endl;
             }
         }
 
@@ -0,0 +1,217 @@
+#include "pipeline.hpp"
+#include "spsc_queue.hpp"
+#include "thread_affinity.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace pucch_f2 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+class OccupancyCounter {
+public:
+    void Sample(std::size_t occupancy) {
+        total_ += occupancy;
+        ++samples_;
+        max_ = std::max(max_, occupancy);
+    }
+
+    void Fill(PipelineQueueStats& stats) const {
+        stats.mean_occupancy = samples_ > 0 ? static_cast<double>(total_) / samples_ : 0.0;
+        stats.max_occupancy = max_;
+    }
+
+private:
+    uint64_t total_ = 0;
+    uint64_t samples_ = 0;
+    std::size_t max_ = 0;
+};
+
+} // namespace
+
+PipelineSimulator::PipelineSimulator(int code_length, double snr_db, uint32_t seed,
+                                     const PipelineOptions& options)
+    : PipelineSimulator(PucchF2Code(code_length), snr_db, seed, options) {}
+
+PipelineSimulator::PipelineSimulator(const BlockCode& code, double snr_db, uint32_t seed,
+                                     const PipelineOptions& options)
+    : simulator_(code, snr_db, seed), options_(options) {
+    if (options_.queue_capacity == 0) {
+        throw std::invalid_argument("queue_capacity must be positive");
+    }
+
+    if (!options_.pin_cores.empty() &&
+        static_cast<int>(options_.pin_cores.size()) != kNumStages) {
+        throw std::invalid_argument("pin_cores must list " + std::to_string(kNumStages) +
+                                    " cores, got " + std::to_string(options_.pin_cores.size()));
+    }
+}
+
+SimulationStats PipelineSimulator::Run(const FrameRange& range) {
+    ChannelSimulator::ValidateRange(range);
+
+    SpscQueue<FrameBatch*> generated(options_.queue_capacity);
+    SpscQueue<FrameBatch*> transmitted(options_.queue_capacity);
+
+    // Enough batches to fill both queues and keep one in every stage; the recycle queue
+    // returns them to the generator, which stalls when all of them are in flight.
+    const std::size_t pool_size = generated.Capacity() + transmitted.Capacity() + kNumStages;
+    std::vector<std::unique_ptr<FrameBatch>> pool;
+    SpscQueue<FrameBatch*> recycled(pool_size);
+    for (std::size_t i = 0; i < pool_size; ++i) {
+        pool.push_back(std::make_unique<FrameBatch>());
+        recycled.TryPush(pool.back().get());
+    }
+
+    stats_ = PipelineStats();
+    stats_.stages[0].name = "generate";
+    stats_.stages[1].name = "channel";
+    stats_.stages[2].name = "decode";
+    stats_.queues[0].name = "generate->channel";
+    stats_.queues[0].capacity = generated.Capacity();
+    stats_.queues[1].name = "channel->decode";
+    stats_.queues[1].capacity = transmitted.Capacity();
+
+    std::atomic<bool> aborted{false};
+    std::exception_ptr errors[kNumStages];
+    OccupancyCounter occupancy[2];
+    SimulationStats result = simulator_.EmptyStats();
+
+    auto pop = [&](SpscQueue<FrameBatch*>& queue, PipelineStageStats& stage, FrameBatch*& batch) {
+        if (queue.TryPop(batch)) {
+            return true;
+        }
+        ++stage.starved_waits;
+        PUCCH_TRACE_SCOPE("wait input");
+        while (!queue.TryPop(batch)) {
+            if (aborted.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    };
+
+    auto push = [&](SpscQueue<FrameBatch*>& queue, int queue_index, FrameBatch* batch) {
+        occupancy[queue_index].Sample(queue.Size());
+        if (queue.TryPush(batch)) {
+            return true;
+        }
+        ++stats_.queues[queue_index].full_waits;
+        PUCCH_TRACE_SCOPE("wait output");
+        while (!queue.TryPush(batch)) {
+            if (aborted.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    };
+
+    auto run_stage = [&](int stage, auto&& body) {
+        PUCCH_TRACE_THREAD_NAME("pipeline " + stats_.stages[stage].name);
+        try {
+            if (!options_.pin_cores.empty()) {
+                PinCurrentThread(options_.pin_cores[stage]);
+            }
+            body(stats_.stages[stage]);
+        } catch (...) {
+            errors[stage] = std::current_exception();
+            aborted.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    auto generate_stage = [&](PipelineStageStats& stage) {
+        for (int64_t first = range.first_frame; first < range.last_frame;
+             first += kFramesPerBatch) {
+            FrameBatch* batch = nullptr;
+            if (!pop(recycled, stage, batch)) {
+                return;
+            }
+
+            auto start = Clock::now();
+            batch->first_frame = first;
+            batch->num_frames = std::min(kFramesPerBatch, range.last_frame - first);
+            simulator_.GenerateBatch(*batch);
+            stage.busy_seconds += SecondsSince(start);
+            ++stage.batches;
+
+            if (!push(generated, 0, batch)) {
+                return;
+            }
+        }
+        push(generated, 0, nullptr);
+    };
+
+    auto channel_stage = [&](PipelineStageStats& stage) {
+        FrameBatch* batch = nullptr;
+        while (pop(generated, stage, batch) && batch != nullptr) {
+            auto start = Clock::now();
+            simulator_.TransmitBatch(*batch);
+            stage.busy_seconds += SecondsSince(start);
+            ++stage.batches;
+
+            if (!push(transmitted, 1, batch)) {
+                return;
+            }
+        }
+        push(transmitted, 1, nullptr);
+    };
+
+    auto decode_stage = [&](PipelineStageStats& stage) {
+        FrameBatch* batch = nullptr;
+        while (pop(transmitted, stage, batch) && batch != nullptr) {
+            auto start = Clock::now();
+            simulator_.DecodeBatch(*batch, result);
+            stage.busy_seconds += SecondsSince(start);
+            ++stage.batches;
+
+            recycled.TryPush(batch);
+        }
+    };
+
+    auto wall_start = Clock::now();
+    std::thread threads[] = {
+        std::thread([&] { run_stage(0, generate_stage); }),
+        std::thread([&] { run_stage(1, channel_stage); }),
+        std::thread([&] { run_stage(2, decode_stage); }),
+    };
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    stats_.wall_seconds = SecondsSince(wall_start);
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    occupancy[0].Fill(stats_.queues[0]);
+    occupancy[1].Fill(stats_.queues[1]);
+
+    return result;
+}
+
+void PipelineSimulator::SetFailedFramesLimit(std::size_t limit) {
+    simulator_.SetFailedFramesLimit(limit);
+}
+
+const PipelineStats& PipelineSimulator::Stats() const {
+    return stats_;
+}
+
+} // namespace pucch_f2
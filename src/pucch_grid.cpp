@@ -0,0 +1,119 @@
+#include "pucch_grid.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace pucch_f2 {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr int kZadoffChuLength = 11;
+constexpr int kZadoffChuRoot = 1;
+
+// exp(j * 2 * pi * shift * n / 12): a cyclic shift in time is a phase ramp across subcarriers.
+std::complex<double> PhaseRamp(int cyclic_shift, int subcarrier) {
+    return std::polar(1.0, 2.0 * kPi * cyclic_shift * subcarrier / kNumSubcarriers);
+}
+
+} // namespace
+
+const std::array<int, kNumDataSymbols> kDataSymbolIndices = {0, 2, 3, 4, 6, 7, 9, 10, 11, 13};
+const std::array<int, kNumDmrsSymbols> kDmrsSymbolIndices = {1, 5, 8, 12};
+
+const std::array<std::complex<double>, kNumSubcarriers>& BaseSequence() {
+    static const auto sequence = [] {
+        std::array<std::complex<double>, kNumSubcarriers> result;
+        for (int n = 0; n < kNumSubcarriers; ++n) {
+            int m = n % kZadoffChuLength;
+            result[n] = std::polar(1.0, -kPi * kZadoffChuRoot * m * (m + 1) / kZadoffChuLength);
+        }
+        return result;
+    }();
+    return sequence;
+}
+
+PucchGridMapper::PucchGridMapper(int cyclic_shift) {
+    if (cyclic_shift < 0 || cyclic_shift >= kNumCyclicShifts) {
+        throw std::invalid_argument("Invalid cyclic shift: " + std::to_string(cyclic_shift) +
+                                    ". Must be in [0, " + std::to_string(kNumCyclicShifts) + ")");
+    }
+
+    const auto& base = BaseSequence();
+    for (int n = 0; n < kNumSubcarriers; ++n) {
+        sequence_[n] = base[n] * PhaseRamp(cyclic_shift, n);
+    }
+}
+
+void PucchGridMapper::Map(const std::vector<std::complex<double>>& symbols,
+                          std::complex<double> channel, ResourceGrid& grid) const {
+    if (symbols.size() != static_cast<std::size_t>(kNumDataSymbols)) {
+        throw std::invalid_argument("Expected " + std::to_string(kNumDataSymbols) +
+                                    " QPSK symbols, got " + std::to_string(symbols.size()));
+    }
+
+    for (int i = 0; i < kNumDataSymbols; ++i) {
+        const std::complex<double> value = channel * symbols[i];
+        auto& row = grid[kDataSymbolIndices[i]];
+        for (int n = 0; n < kNumSubcarriers; ++n) {
+            row[n] += value * sequence_[n];
+        }
+    }
+
+    for (int l : kDmrsSymbolIndices) {
+        auto& row = grid[l];
+        for (int n = 0; n < kNumSubcarriers; ++n) {
+            row[n] += channel * sequence_[n];
+        }
+    }
+}
+
+PucchGridReceiver::PucchGridReceiver() {
+    const auto& base = BaseSequence();
+    for (int m = 0; m < kNumCyclicShifts; ++m) {
+        for (int n = 0; n < kNumSubcarriers; ++n) {
+            matrix_[m][n] = std::conj(base[n] * PhaseRamp(m, n)) / double(kNumSubcarriers);
+        }
+    }
+}
+
+void PucchGridReceiver::Despread(const ResourceGrid& grid, ResourceGrid& despread) const {
+    for (int l = 0; l < kNumGridSymbols; ++l) {
+        const auto& row = grid[l];
+        for (int m = 0; m < kNumCyclicShifts; ++m) {
+            const auto& weights = matrix_[m];
+            // Spelled out so that the loop vectorizes instead of calling the NaN-aware
+            // std::complex multiplication.
+            double re = 0.0;
+            double im = 0.0;
+            for (int n = 0; n < kNumSubcarriers; ++n) {
+                re += row[n].real() * weights[n].real() - row[n].imag() * weights[n].imag();
+                im += row[n].real() * weights[n].imag() + row[n].imag() * weights[n].real();
+            }
+            despread[l][m] = {re, im};
+        }
+    }
+}
+
+std::complex<double> PucchGridReceiver::EstimateChannel(const ResourceGrid& despread,
+                                                        int cyclic_shift) {
+    std::complex<double> sum = 0.0;
+    for (int l : kDmrsSymbolIndices) {
+        sum += despread[l][cyclic_shift];
+    }
+    return sum / double(kNumDmrsSymbols);
+}
+
+std::vector<std::complex<double>> PucchGridReceiver::Equalize(const ResourceGrid& despread,
+                                                              int cyclic_shift,
+                                                              std::complex<double> channel) {
+    std::vector<std::complex<double>> symbols(kNumDataSymbols);
+    const std::complex<double> inverse = 1.0 / channel;
+    for (int i = 0; i < kNumDataSymbols; ++i) {
+        symbols[i] = despread[kDataSymbolIndices[i]][cyclic_shift] * inverse;
+    }
+    return symbols;
+}
+
+} // namespace pucch_f2
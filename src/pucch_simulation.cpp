@@ -0,0 +1,145 @@
+#include "pucch_simulation.hpp"
+#include "channel.hpp"
+#include "frame_rng.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace pucch_f2 {
+
+FadingModel ParseFadingModel(const std::string& name) {
+    if (name == "awgn") {
+        return FadingModel::kAwgn;
+    }
+    if (name == "rayleigh") {
+        return FadingModel::kRayleigh;
+    }
+    throw std::invalid_argument("Unknown channel model: '" + name +
+                                "'. Valid models: 'awgn', 'rayleigh'");
+}
+
+PucchSimulator::PucchSimulator(int code_length, double snr_db, int num_ues, FadingModel fading,
+                               uint32_t seed)
+    : PucchSimulator(PucchF2Code(code_length), snr_db, num_ues, fading, seed) {}
+
+PucchSimulator::PucchSimulator(const BlockCode& code, double snr_db, int num_ues,
+                               FadingModel fading, uint32_t seed)
+    : code_length_(code.K()), snr_db_(snr_db), num_ues_(num_ues), fading_(fading), seed_(seed),
+      encoder_(code), decoder_(code), channels_(num_ues) {
+    if (code.N() != 2 * kNumDataSymbols) {
+        throw std::invalid_argument("PUCCH format 2 carries " +
+                                    std::to_string(2 * kNumDataSymbols) +
+                                    " coded bits, code '" + code.Name() + "' has " +
+                                    std::to_string(code.N()));
+    }
+
+    if (num_ues < 1 || num_ues > kNumCyclicShifts) {
+        throw std::invalid_argument("Invalid number of UEs: " + std::to_string(num_ues) +
+                                    ". Must be in [1, " + std::to_string(kNumCyclicShifts) + "]");
+    }
+
+    for (int ue = 0; ue < num_ues_; ++ue) {
+        mappers_.emplace_back(CyclicShift(ue, num_ues_));
+    }
+}
+
+int PucchSimulator::CyclicShift(int ue, int num_ues) {
+    return ue * kNumCyclicShifts / num_ues;
+}
+
+void PucchSimulator::GenerateChannels(int64_t frame) {
+    if (fading_ == FadingModel::kAwgn) {
+        std::fill(channels_.begin(), channels_.end(), std::complex<double>(1.0, 0.0));
+        return;
+    }
+
+    FrameRng rng(seed_, frame, RngPurpose::kFading);
+    std::normal_distribution<double> gain(0.0, std::sqrt(0.5));
+    for (auto& channel : channels_) {
+        double re = gain(rng);
+        double im = gain(rng);
+        channel = {re, im};
+    }
+}
+
+void PucchSimulator::AddNoise(int64_t frame, ResourceGrid& grid) const {
+    FrameRng rng(seed_, frame, RngPurpose::kNoise);
+    std::normal_distribution<double> noise(0.0, AwgnChannel::Sigma(snr_db_));
+    for (auto& row : grid) {
+        for (auto& element : row) {
+            double re = noise(rng);
+            double im = noise(rng);
+            element += std::complex<double>(re, im);
+        }
+    }
+}
+
+PucchSimulationResult PucchSimulator::Run(const FrameRange& range) {
+    ChannelSimulator::ValidateRange(range);
+
+    PucchSimulationResult result;
+    result.stats.Resize(code_length_);
+    result.failed_per_ue.assign(num_ues_, 0);
+
+    std::vector<uint32_t> sent(num_ues_);
+    std::vector<uint8_t> data(code_length_);
+    ResourceGrid grid;
+    ResourceGrid despread;
+    double squared_error = 0.0;
+    // Despreading adds the energy of the 12 subcarriers of a symbol.
+    const double despread_snr_db = snr_db_ + 10.0 * std::log10(double(kNumSubcarriers));
+
+    const int64_t fast_path_hits = decoder_.FastPathHits();
+
+    for (int64_t frame = range.first_frame; frame < range.last_frame; ++frame) {
+        PUCCH_TRACE_SCOPE_FINE("PucchSimulator::Frame");
+
+        for (auto& row : grid) {
+            row.fill({0.0, 0.0});
+        }
+
+        GenerateChannels(frame);
+        FrameRng message_rng(seed_, frame, RngPurpose::kMessage);
+        for (int ue = 0; ue < num_ues_; ++ue) {
+            sent[ue] = static_cast<uint32_t>(message_rng() & ((1u << code_length_) - 1));
+            for (int i = 0; i < code_length_; ++i) {
+                data[i] = static_cast<uint8_t>((sent[ue] >> i) & 1);
+            }
+            mappers_[ue].Map(modulator_.Modulate(encoder_.Encode(data)), channels_[ue], grid);
+        }
+
+        AddNoise(frame, grid);
+        receiver_.Despread(grid, despread);
+
+        for (int ue = 0; ue < num_ues_; ++ue) {
+            const int shift = CyclicShift(ue, num_ues_);
+            const std::complex<double> estimate =
+                PucchGridReceiver::EstimateChannel(despread, shift);
+            squared_error += std::norm(estimate - channels_[ue]);
+
+            // LLRs scale with the estimated channel gain, as a receiver would weight them.
+            const double snr_db = despread_snr_db + 10.0 * std::log10(std::norm(estimate));
+            auto llr = demodulator_.Demodulate(
+                PucchGridReceiver::Equalize(despread, shift, estimate), snr_db);
+            const auto decoded = static_cast<uint32_t>(decoder_.DecodeIndex(llr));
+
+            result.stats.Record(frame, sent[ue], decoded);
+            if (decoded != sent[ue]) {
+                ++result.failed_per_ue[ue];
+            }
+        }
+    }
+
+    result.stats.fast_path_hits = decoder_.FastPathHits() - fast_path_hits;
+    if (result.stats.frames > 0) {
+        result.channel_estimation_mse = squared_error / result.stats.frames;
+    }
+
+    return result;
+}
+
+} // namespace pucch_f2
@@ -0,0 +1,231 @@
+#include "simulation.hpp"
+#include "frame_rng.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace pucch_f2 {
+
+void SimulationStats::Resize(int code_length) {
+    bit_errors.resize(code_length, 0);
+    error_weights.resize(code_length + 1, 0);
+    decoded_errors.resize(std::size_t{1} << code_length, 0);
+}
+
+void SimulationStats::Record(int64_t frame, uint32_t sent, uint32_t decoded) {
+    uint32_t error_pattern = sent ^ decoded;
+    int64_t is_error = error_pattern != 0;
+
+    for (std::size_t i = 0; i < bit_errors.size(); ++i) {
+        bit_errors[i] += (error_pattern >> i) & 1u;
+    }
+    ++error_weights[__builtin_popcount(error_pattern)];
+    decoded_errors[decoded] += is_error;
+
+    ++frames;
+    failed += is_error;
+    success += 1 - is_error;
+
+    if (is_error && failed_frames.size() < failed_frames_limit) {
+        failed_frames.push_back(frame);
+    }
+}
+
+void SimulationStats::Merge(const SimulationStats& other) {
+    frames += other.frames;
+    success += other.success;
+    failed += other.failed;
+    fast_path_hits += other.fast_path_hits;
+
+    auto add = [](std::vector<int64_t>& to, const std::vector<int64_t>& from) {
+        if (to.size() < from.size()) {
+            to.resize(from.size(), 0);
+        }
+        for (std::size_t i = 0; i < from.size(); ++i) {
+            to[i] += from[i];
+        }
+    };
+
+    add(bit_errors, other.bit_errors);
+    add(error_weights, other.error_weights);
+    add(decoded_errors, other.decoded_errors);
+
+    failed_frames_limit = std::max(failed_frames_limit, other.failed_frames_limit);
+    failed_frames.insert(failed_frames.end(), other.failed_frames.begin(),
+                         other.failed_frames.end());
+    std::sort(failed_frames.begin(), failed_frames.end());
+    if (failed_frames.size() > failed_frames_limit) {
+        failed_frames.resize(failed_frames_limit);
+    }
+}
+
+int64_t SimulationStats::TotalBitErrors() const {
+    int64_t total = 0;
+    for (int64_t errors : bit_errors) {
+        total += errors;
+    }
+    return total;
+}
+
+FrameRange ComputeShardRange(int64_t iterations, int shard_index, int shard_count) {
+    if (iterations < 0) {
+        throw std::invalid_argument("iterations must be non-negative, got " +
+                                    std::to_string(iterations));
+    }
+
+    if (shard_count <= 0 || shard_index < 0 || shard_index >= shard_count) {
+        throw std::invalid_argument("Invalid shard: index " + std::to_string(shard_index) +
+                                    " of " + std::to_string(shard_count));
+    }
+
+    // Every frame is derived from (seed, frame index), so ranges need no batch alignment.
+    auto boundary = [&](int index) {
+        return iterations / shard_count * index + iterations % shard_count * index / shard_count;
+    };
+
+    return {boundary(shard_index), boundary(shard_index + 1)};
+}
+
+std::pair<double, double> WilsonInterval(int64_t failed, int64_t trials, double z) {
+    if (trials <= 0) {
+        return {0.0, 1.0};
+    }
+
+    double n = static_cast<double>(trials);
+    double p = static_cast<double>(failed) / n;
+    double z2 = z * z;
+    double denominator = 1.0 + z2 / n;
+    double center = (p + z2 / (2.0 * n)) / denominator;
+    double half_width = z * std::sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denominator;
+
+    return {std::max(0.0, center - half_width), std::min(1.0, center + half_width)};
+}
+
+ChannelSimulator::ChannelSimulator(int code_length, double snr_db, uint32_t seed)
+    : ChannelSimulator(PucchF2Code(code_length), snr_db, seed) {}
+
+ChannelSimulator::ChannelSimulator(const BlockCode& code, double snr_db, uint32_t seed)
+    : code_length_(code.K()), snr_db_(snr_db), seed_(seed), encoder_(code),
+      channel_(snr_db, seed), decoder_(code) {}
+
+void ChannelSimulator::ValidateRange(const FrameRange& range) {
+    if (range.first_frame < 0 || range.last_frame < range.first_frame) {
+        throw std::invalid_argument("Invalid frame range [" + std::to_string(range.first_frame) +
+                                    ", " + std::to_string(range.last_frame) + ")");
+    }
+}
+
+SimulationStats ChannelSimulator::Run(const FrameRange& range) {
+    ValidateRange(range);
+
+    SimulationStats stats = EmptyStats();
+    FrameBatch batch;
+
+    for (int64_t first = range.first_frame; first < range.last_frame; first += kFramesPerBatch) {
+        batch.first_frame = first;
+        batch.num_frames = std::min(kFramesPerBatch, range.last_frame - first);
+
+        GenerateBatch(batch);
+        TransmitBatch(batch);
+        DecodeBatch(batch, stats);
+    }
+
+    return stats;
+}
+
+void ChannelSimulator::SetFailedFramesLimit(std::size_t limit) {
+    failed_frames_limit_ = limit;
+}
+
+SimulationStats ChannelSimulator::EmptyStats() const {
+    SimulationStats stats;
+    stats.Resize(code_length_);
+    stats.failed_frames_limit = failed_frames_limit_;
+    return stats;
+}
+
+void ChannelSimulator::GenerateMessage(int64_t frame, std::vector<uint8_t>& data) {
+    FrameRng rng(seed_, frame, RngPurpose::kMessage);
+    uint64_t bits = rng();
+
+    data.resize(code_length_);
+    for (int i = 0; i < code_length_; ++i) {
+        data[i] = static_cast<uint8_t>((bits >> i) & 1);
+    }
+}
+
+void ChannelSimulator::GenerateBatch(FrameBatch& batch) {
+    PUCCH_TRACE_SCOPE("generate batch");
+
+    batch.data.resize(batch.num_frames);
+    batch.symbols.resize(batch.num_frames);
+
+    for (int64_t frame = 0; frame < batch.num_frames; ++frame) {
+        GenerateMessage(batch.first_frame + frame, batch.data[frame]);
+
+        auto codeword = encoder_.Encode(batch.data[frame]);
+        batch.symbols[frame] = modulator_.Modulate(codeword);
+    }
+}
+
+void ChannelSimulator::TransmitBatch(FrameBatch& batch) {
+    PUCCH_TRACE_SCOPE("channel batch");
+
+    for (int64_t frame = 0; frame < batch.num_frames; ++frame) {
+        channel_.Seek(batch.first_frame + frame);
+        batch.symbols[frame] = channel_.Transmit(batch.symbols[frame]);
+    }
+}
+
+void ChannelSimulator::DecodeBatch(const FrameBatch& batch, SimulationStats& stats) {
+    PUCCH_TRACE_SCOPE("decode batch");
+    stats.Resize(code_length_);
+    stats.failed_frames_limit = failed_frames_limit_;
+    const int64_t fast_path_hits = decoder_.FastPathHits();
+
+    for (int64_t frame = 0; frame < batch.num_frames; ++frame) {
+        auto llr = demodulator_.Demodulate(batch.symbols[frame], snr_db_);
+        uint32_t decoded = static_cast<uint32_t>(decoder_.DecodeIndex(llr));
+
+        uint32_t sent = 0;
+        for (int i = 0; i < code_length_; ++i) {
+            sent |= static_cast<uint32_t>(batch.data[frame][i]) << i;
+        }
+
+        stats.Record(batch.first_frame + frame, sent, decoded);
+    }
+
+    stats.fast_path_hits += decoder_.FastPathHits() - fast_path_hits;
+}
+
+FrameTrace ChannelSimulator::ReplayFrame(int64_t frame) {
+    if (frame < 0) {
+        throw std::invalid_argument("Frame index must be non-negative, got " +
+                                    std::to_string(frame));
+    }
+
+    FrameTrace trace;
+    trace.frame = frame;
+
+    GenerateMessage(frame, trace.data);
+    trace.codeword = encoder_.Encode(trace.data);
+    trace.symbols = modulator_.Modulate(trace.codeword);
+
+    channel_.Seek(frame);
+    trace.received = channel_.Transmit(trace.symbols, trace.noise);
+
+    trace.llr = demodulator_.Demodulate(trace.received, snr_db_);
+    trace.metrics = decoder_.ComputeMetrics(trace.llr);
+    trace.decoded_index = decoder_.DecodeIndex(trace.llr);
+
+    for (int i = 0; i < code_length_; ++i) {
+        trace.sent_index |= trace.data[i] << i;
+    }
+
+    return trace;
+}
+
+} // namespace pucch_f2
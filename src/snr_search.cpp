@@ -0,0 +1,182 @@
+#include "snr_search.hpp"
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace pucch_f2 {
+
+double SnrProbe::Bler() const {
+    return frames > 0 ? static_cast<double>(failed) / frames : 0.0;
+}
+
+bool SnrProbe::AboveTarget(double target_bler) const {
+    if (bler_ci_low > target_bler) {
+        return true;
+    }
+    if (bler_ci_high < target_bler) {
+        return false;
+    }
+    return Bler() > target_bler;
+}
+
+SnrSearch::SnrSearch(const SnrSearchOptions& options, uint32_t seed)
+    : options_(options), seed_(seed) {
+    if (options_.target_bler <= 0.0 || options_.target_bler >= 1.0) {
+        throw std::invalid_argument("target_bler must be in (0, 1), got " +
+                                    std::to_string(options_.target_bler));
+    }
+
+    if (options_.snr_low_db >= options_.snr_high_db) {
+        throw std::invalid_argument("snr_low_db must be below snr_high_db");
+    }
+
+    if (options_.tolerance_db <= 0.0) {
+        throw std::invalid_argument("tolerance_db must be positive, got " +
+                                    std::to_string(options_.tolerance_db));
+    }
+
+    if (options_.min_iterations <= 0 || options_.max_iterations < options_.min_iterations) {
+        throw std::invalid_argument("Invalid iteration limits: min_iterations " +
+                                    std::to_string(options_.min_iterations) +
+                                    ", max_iterations " +
+                                    std::to_string(options_.max_iterations));
+    }
+
+    if (options_.z <= 0.0) {
+        throw std::invalid_argument("Confidence quantile must be positive");
+    }
+}
+
+SnrSearchResult SnrSearch::Run(int code_length) {
+    return Run(PucchF2Code(code_length));
+}
+
+SnrSearchResult SnrSearch::Run(const BlockCode& code) {
+    SnrSearchResult result;
+    result.code_length = code.K();
+    const std::string code_name = code.Name() + " (" + std::to_string(code.N()) + ", " +
+                                  std::to_string(code.K()) + ")";
+
+    auto probe = [&](double snr_db, double band) {
+        SnrProbe point = Probe(code, snr_db, band);
+        result.total_frames += point.frames;
+        result.resolved = result.resolved && point.resolved;
+        result.probes.push_back(point);
+        return point;
+    };
+    auto above = [&](const SnrProbe& point) { return point.AboveTarget(options_.target_bler); };
+
+    double low = options_.snr_low_db;
+    double high = options_.snr_high_db;
+    double width = high - low;
+
+    // While widening, the previous lower end becomes the upper end together with its probe.
+    SnrProbe low_probe = probe(low, 1.0);
+    std::optional<SnrProbe> high_probe;
+
+    int expansions = 0;
+    while (!above(low_probe)) {
+        if (++expansions > kMaxBracketExpansions) {
+            throw std::runtime_error("BLER stays below target down to " + std::to_string(low) +
+                                     " dB for code " + code_name);
+        }
+        high = low;
+        high_probe = low_probe;
+        low -= width;
+        width *= 2.0;
+        low_probe = probe(low, 1.0);
+    }
+
+    if (!high_probe) {
+        high_probe = probe(high, 1.0);
+    }
+
+    expansions = 0;
+    width = high - low;
+    while (above(*high_probe)) {
+        if (++expansions > kMaxBracketExpansions) {
+            throw std::runtime_error("BLER stays above target up to " + std::to_string(high) +
+                                     " dB for code " + code_name);
+        }
+        low = high;
+        low_probe = *high_probe;
+        high += width;
+        width *= 2.0;
+        high_probe = probe(high, 1.0);
+    }
+
+    while (high - low > options_.tolerance_db) {
+        double mid = 0.5 * (low + high);
+        SnrProbe point = probe(mid, TargetBand(low_probe, *high_probe));
+
+        if (point.at_target) {
+            result.snr_low_db = low;
+            result.snr_high_db = high;
+            result.required_snr_db = mid;
+            return result;
+        }
+
+        if (above(point)) {
+            low = mid;
+            low_probe = point;
+        } else {
+            high = mid;
+            high_probe = point;
+        }
+    }
+
+    result.snr_low_db = low;
+    result.snr_high_db = high;
+    result.required_snr_db = 0.5 * (low + high);
+
+    return result;
+}
+
+double SnrSearch::TargetBand(const SnrProbe& low, const SnrProbe& high) const {
+    // With no failures at the upper end its interval bound stands in for the zero estimate.
+    double high_bler = high.failed > 0 ? high.Bler() : high.bler_ci_high;
+    double ratio = low.Bler() / high_bler;
+    if (!(ratio > 1.0)) {
+        return 1.0;
+    }
+    return std::pow(ratio, 0.5 * options_.tolerance_db / (high.snr_db - low.snr_db));
+}
+
+SnrProbe SnrSearch::Probe(const BlockCode& code, double snr_db, double band) {
+    ChannelSimulator simulator(code, snr_db, seed_);
+
+    auto round_to_streams = [](int64_t frames) {
+        return (frames + kFramesPerBatch - 1) / kFramesPerBatch * kFramesPerBatch;
+    };
+    const int64_t max_frames = round_to_streams(options_.max_iterations);
+
+    SnrProbe point;
+    point.snr_db = snr_db;
+
+    int64_t next_frames = round_to_streams(options_.min_iterations);
+    while (true) {
+        SimulationStats stats = simulator.Run({point.frames, next_frames});
+        point.frames += stats.frames;
+        point.failed += stats.failed;
+
+        auto [ci_low, ci_high] = WilsonInterval(point.failed, point.frames, options_.z);
+        point.bler_ci_low = ci_low;
+        point.bler_ci_high = ci_high;
+        point.at_target = band > 1.0 && ci_low > options_.target_bler / band &&
+                          ci_high < options_.target_bler * band;
+        point.resolved = ci_low > options_.target_bler || ci_high < options_.target_bler ||
+                         point.at_target;
+
+        if (point.resolved || point.frames >= max_frames) {
+            return point;
+        }
+
+        next_frames = std::min(2 * point.frames, max_frames);
+    }
+}
+
+} // namespace pucch_f2
@@ -0,0 +1,63 @@
+#include "symbol_io.hpp"
+
+#include <charconv>
+#include <cmath>
+
+namespace pucch_f2 {
+
+namespace {
+
+constexpr int kDecimals = 3;
+// Sign, up to 309 integer digits of a finite double, point and decimals.
+constexpr int kMaxPartChars = 1 + 309 + 1 + kDecimals;
+
+} // namespace
+
+bool ParseComplex(std::string_view text, std::complex<double>& value) {
+    const char* ptr = text.data();
+    const char* end = ptr + text.size();
+
+    // from_chars rejects an explicit '+', which the text form allows on both parts.
+    if (ptr != end && *ptr == '+') {
+        ++ptr;
+    }
+
+    double re = 0.0;
+    auto [re_end, re_ec] = std::from_chars(ptr, end, re);
+    if (re_ec != std::errc() || re_end == end || (*re_end != '+' && *re_end != '-')) {
+        return false;
+    }
+
+    ptr = re_end;
+    if (*ptr == '+') {
+        ++ptr;
+        if (ptr != end && *ptr == '-') {
+            return false;
+        }
+    }
+
+    double im = 0.0;
+    auto [im_end, im_ec] = std::from_chars(ptr, end, im);
+    if (im_ec != std::errc() || im_end + 1 != end || *im_end != 'j') {
+        return false;
+    }
+
+    value = std::complex<double>(re, im);
+    return true;
+}
+
+std::string FormatComplex(const std::complex<double>& value) {
+    char buffer[2 * kMaxPartChars + 2];
+    char* end = buffer + sizeof(buffer);
+
+    char* ptr = std::to_chars(buffer, end, value.real(), std::chars_format::fixed, kDecimals).ptr;
+    if (!std::signbit(value.imag())) {
+        *ptr++ = '+';
+    }
+    ptr = std::to_chars(ptr, end - 1, value.imag(), std::chars_format::fixed, kDecimals).ptr;
+    *ptr++ = 'j';
+
+    return std::string(buffer, ptr);
+}
+
+} // namespace pucch_f2
@@ -0,0 +1,30 @@
+#include "thread_affinity.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace pucch_f2 {
+
+void PinCurrentThread(int core) {
+#ifdef __linux__
+    if (core < 0 || core >= CPU_SETSIZE) {
+        throw std::invalid_argument("Invalid core index " + std::to_string(core));
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core, &cpu_set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+        throw std::runtime_error("Cannot pin thread to core " + std::to_string(core));
+    }
+#else
+    (void)core;
+#endif
+}
+
+} // namespace pucch_f2
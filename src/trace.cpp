@@ -0,0 +1,186 @@
+#include "trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace pucch_f2::trace {
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+};
+
+// Appended to only by its own thread; owned by the registry so it outlives the thread. Other
+// threads read only the atomic counters while the owner may be recording.
+struct ThreadBuffer {
+    int tid;
+    std::string name;
+    std::vector<Event> events;
+    std::atomic<std::size_t> recorded{0};
+    std::atomic<std::size_t> dropped{0};
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+std::atomic<bool> enabled{false};
+const auto epoch = std::chrono::steady_clock::now();
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+ThreadBuffer& GetThreadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+
+    if (buffer == nullptr) {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto owned = std::make_unique<ThreadBuffer>();
+        owned->tid = static_cast<int>(registry.buffers.size()) + 1;
+        owned->name = owned->tid == 1 ? "main" : "worker " + std::to_string(owned->tid);
+        owned->events.reserve(4096);
+        buffer = owned.get();
+        registry.buffers.push_back(std::move(owned));
+    }
+
+    return *buffer;
+}
+
+uint64_t NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - epoch)
+                                     .count());
+}
+
+void WriteMicroseconds(std::ofstream& file, uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    file << text;
+}
+
+void WriteEscaped(std::ofstream& file, const std::string& text) {
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            file << '\\';
+        }
+        file << c;
+    }
+}
+
+} // namespace
+
+void Enable() {
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+bool IsEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+bool IsCompiledIn() {
+#ifdef PUCCH_ENABLE_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SetThreadName(const std::string& name) {
+    if (IsEnabled()) {
+        GetThreadBuffer().name = name;
+    }
+}
+
+std::size_t EventCount() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::size_t count = 0;
+    for (const auto& buffer : registry.buffers) {
+        count += buffer->recorded.load(std::memory_order_acquire);
+    }
+    return count;
+}
+
+std::size_t DroppedEventCount() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::size_t count = 0;
+    for (const auto& buffer : registry.buffers) {
+        count += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void WriteChromeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create trace file '" + path + "'");
+    }
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+            "\"args\":{\"name\":\"pucch_codes_modeling\"}}";
+
+    for (const auto& buffer : registry.buffers) {
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+             << ",\"args\":{\"name\":\"";
+        WriteEscaped(file, buffer->name);
+        file << "\"}}";
+
+        for (const Event& event : buffer->events) {
+            file << ",\n{\"name\":\"";
+            WriteEscaped(file, event.name);
+            file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                 << ",\"ts\":";
+            WriteMicroseconds(file, event.start_ns);
+            file << ",\"dur\":";
+            WriteMicroseconds(file, event.duration_ns);
+            file << '}';
+        }
+    }
+
+    file << "\n]}\n";
+}
+
+ScopedSpan::ScopedSpan(const char* name) : name_(name), start_ns_(0) {
+    if (IsEnabled()) {
+        start_ns_ = NowNs();
+    } else {
+        name_ = nullptr;
+    }
+}
+
+ScopedSpan::~ScopedSpan() {
+    if (name_ != nullptr) {
+        uint64_t end_ns = NowNs();
+        ThreadBuffer& buffer = GetThreadBuffer();
+        if (buffer.events.size() < kMaxEventsPerThread) {
+            buffer.events.push_back({name_, start_ns_, end_ns - start_ns_});
+            buffer.recorded.store(buffer.events.size(), std::memory_order_release);
+        } else {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace pucch_f2::trace
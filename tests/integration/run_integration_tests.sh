@@ -32,6 +32,7 @@ for test_file in *.json; do
         fi
     fi
 done
+rm -fr result.json
 
 echo ""
 echo "========================================"
@@ -0,0 +1,62 @@
+#include "block_code.hpp"
+#include "decoder.hpp"
+#include "encoder.hpp"
+#include <gtest/gtest.h>
+
+TEST(BlockCodeTest, RegisteredCodesHaveFullRank) {
+    for (const auto& name : pucch_f2::BlockCodeNames()) {
+        for (int k : pucch_f2::BlockCodeDimensions(name)) {
+            const auto& code = pucch_f2::GetBlockCode(name, k);
+            EXPECT_EQ(code.K(), k);
+            EXPECT_TRUE(code.IsFullRank()) << name << " k=" << k;
+        }
+    }
+}
+
+TEST(BlockCodeTest, ReedMullerMinimumDistance) {
+    // Sizes up to 6 are the first-order Reed-Muller code RM(1, 5).
+    const int expected[] = {32, 16, 16, 16, 16, 16, 12, 12, 12, 12, 10};
+    for (int k = 1; k <= 11; ++k) {
+        const auto& code = pucch_f2::GetBlockCode(pucch_f2::kReedMuller32CodeName, k);
+        EXPECT_EQ(code.N(), 32);
+        EXPECT_EQ(code.MinimumDistance(), expected[k - 1]) << "k=" << k;
+    }
+}
+
+TEST(BlockCodeTest, DescriptorsAreCached) {
+    const auto& first = pucch_f2::GetBlockCode(pucch_f2::kReedMuller32CodeName, 7);
+    const auto& second = pucch_f2::GetBlockCode(pucch_f2::kReedMuller32CodeName, 7);
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(&pucch_f2::PucchF2Code(4), &pucch_f2::GetBlockCode(pucch_f2::kPucchF2CodeName, 4));
+}
+
+TEST(BlockCodeTest, InvalidDescriptors) {
+    EXPECT_THROW(pucch_f2::GetBlockCode("golay", 12), std::invalid_argument);
+    EXPECT_THROW(pucch_f2::GetBlockCode(pucch_f2::kReedMuller32CodeName, 12), std::invalid_argument);
+    EXPECT_THROW(pucch_f2::GetBlockCode(pucch_f2::kPucchF2CodeName, 3), std::invalid_argument);
+    EXPECT_THROW(pucch_f2::BlockCode("short", 4, 2, {1, 2, 3}), std::invalid_argument);
+}
+
+TEST(BlockCodeTest, ReedMullerRoundTrip) {
+    const auto& code = pucch_f2::GetBlockCode(pucch_f2::kReedMuller32CodeName, 11);
+    pucch_f2::Encoder encoder(code);
+    pucch_f2::Decoder decoder(code);
+
+    for (int idx = 0; idx < code.NumCodewords(); idx += 37) {
+        std::vector<uint8_t> data(code.K());
+        for (int i = 0; i < code.K(); ++i) {
+            data[i] = (idx >> i) & 1;
+        }
+
+        auto codeword = encoder.Encode(data);
+        ASSERT_EQ(codeword.size(), 32u);
+
+        // Flip fewer than d_min / 2 positions; ML decoding must still recover the message.
+        std::vector<double> llr(codeword.size());
+        for (std::size_t i = 0; i < codeword.size(); ++i) {
+            llr[i] = (codeword[i] == 0 ? 1.0 : -1.0) * (i < 4 ? -0.5 : 1.0);
+        }
+
+        EXPECT_EQ(decoder.Decode(llr), data) << "Message " << idx;
+    }
+}
@@ -65,4 +65,20 @@ TEST(ChannelTest, VectorTransmission) {
     for (size_t i = 0; i < symbols.size(); ++i) {
         EXPECT_NEAR(std::abs(received[i] - symbols[i]), 0, 0.5);
     }
-}
\ No newline at end of file
+}
+
+TEST(ChannelTest, UnitNoiseScalesToTransmitNoise) {
+    const double snr_db = 3.0;
+    pucch_f2::AwgnChannel ch1(snr_db, 77);
+    pucch_f2::AwgnChannel ch2(snr_db, 77);
+
+    std::vector<std::complex<double>> zeros(10, {0.0, 0.0});
+    auto received = ch1.Transmit(zeros);
+    auto unit_noise = ch2.GenerateUnitNoise(zeros.size());
+
+    double sigma = pucch_f2::AwgnChannel::Sigma(snr_db);
+    for (size_t i = 0; i < zeros.size(); ++i) {
+        EXPECT_NEAR(received[i].real(), sigma * unit_noise[i].real(), 1e-12);
+        EXPECT_NEAR(received[i].imag(), sigma * unit_noise[i].imag(), 1e-12);
+    }
+}
@@ -0,0 +1,40 @@
+#include "crn_sweep.hpp"
+#include <gtest/gtest.h>
+
+TEST(CrnSweepTest, InvalidInput) {
+    EXPECT_THROW(pucch_f2::CrnSweep({}, {0.0}, 1), std::invalid_argument);
+    EXPECT_THROW(pucch_f2::CrnSweep({2}, {}, 1), std::invalid_argument);
+    EXPECT_THROW(pucch_f2::CrnSweep({3}, {0.0}, 1), std::invalid_argument);
+}
+
+TEST(CrnSweepTest, StatisticsShape) {
+    pucch_f2::CrnSweep sweep({2, 11}, {-6.0, 0.0, 20.0}, 42);
+    auto stats = sweep.Run({0, 500});
+
+    ASSERT_EQ(stats.size(), 2u);
+    for (const auto& per_length : stats) {
+        ASSERT_EQ(per_length.size(), 3u);
+        for (const auto& point : per_length) {
+            EXPECT_EQ(point.frames, 500);
+            EXPECT_EQ(point.success + point.failed, 500);
+        }
+        EXPECT_EQ(per_length[2].failed, 0);
+    }
+}
+
+TEST(CrnSweepTest, SharedNoiseOrdersCurves) {
+    // With common noise the BLER curves keep their order point by point: longer messages
+    // and lower SNR never do better on the same noise realizations in aggregate.
+    pucch_f2::CrnSweep sweep({2, 6, 11}, {-8.0, -4.0, 0.0}, 7);
+    auto stats = sweep.Run({0, 3 * pucch_f2::kFramesPerBatch});
+
+    for (std::size_t len = 0; len < stats.size(); ++len) {
+        for (std::size_t snr = 1; snr < stats[len].size(); ++snr) {
+            EXPECT_LE(stats[len][snr].failed, stats[len][snr - 1].failed);
+        }
+    }
+    for (std::size_t snr = 0; snr < stats[0].size(); ++snr) {
+        EXPECT_LE(stats[0][snr].failed, stats[1][snr].failed);
+        EXPECT_LE(stats[1][snr].failed, stats[2][snr].failed);
+    }
+}
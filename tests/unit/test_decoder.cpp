@@ -4,6 +4,8 @@
 #include "modulator.hpp"
 #include <gtest/gtest.h>
 
+#include <random>
+
 TEST(DecoderTest, ValidCodeLengths) {
     for (int len : pucch_f2::kValidCodeLengths) {
         EXPECT_NO_THROW(pucch_f2::Decoder decoder(len));
@@ -59,3 +61,88 @@ TEST(DecoderTest, DecodeDeterministic) {
 
     EXPECT_EQ(dec1, dec2);
 }
+
+TEST(DecoderTest, DecodeIndexMatchesDecode) {
+    pucch_f2::Encoder encoder(6);
+    pucch_f2::QpskModulator modulator;
+    pucch_f2::QpskDemodulator demodulator;
+    pucch_f2::Decoder decoder(6);
+
+    std::vector<uint8_t> data = {1, 1, 0, 1, 0, 0};
+    auto llr = demodulator.Demodulate(modulator.Modulate(encoder.Encode(data)), 100);
+
+    EXPECT_EQ(decoder.DecodeIndex(llr), 0b001011);
+    EXPECT_EQ(decoder.Decode(llr), data);
+}
+
+TEST(DecoderTest, IndependentDecodersOfDifferentLengths) {
+    pucch_f2::Decoder short_decoder(2);
+    pucch_f2::Decoder long_decoder(11);
+
+    for (int code_len : {2, 11}) {
+        pucch_f2::Encoder encoder(code_len);
+        pucch_f2::QpskModulator modulator;
+        pucch_f2::QpskDemodulator demodulator;
+
+        std::vector<uint8_t> data(code_len, 1);
+        auto llr = demodulator.Demodulate(modulator.Modulate(encoder.Encode(data)), 100);
+
+        auto& decoder = code_len == 2 ? short_decoder : long_decoder;
+        EXPECT_EQ(decoder.Decode(llr), data) << "Failed for code length " << code_len;
+    }
+}
+
+TEST(DecoderTest, FastPathResolvesEveryNoiselessCodeword) {
+    for (int code_length : pucch_f2::kValidCodeLengths) {
+        pucch_f2::Encoder encoder(code_length);
+        pucch_f2::Decoder decoder(code_length);
+
+        for (int idx = 0; idx < (1 << code_length); ++idx) {
+            std::vector<uint8_t> data(code_length);
+            for (int i = 0; i < code_length; ++i) {
+                data[i] = (idx >> i) & 1;
+            }
+
+            auto codeword = encoder.Encode(data);
+            std::vector<double> llr(codeword.size());
+            for (std::size_t i = 0; i < codeword.size(); ++i) {
+                llr[i] = codeword[i] == 0 ? 1.0 : -1.0;
+            }
+
+            EXPECT_EQ(decoder.DecodeIndex(llr), idx) << "Length " << code_length;
+        }
+
+        EXPECT_EQ(decoder.DecodeCalls(), 1 << code_length);
+        EXPECT_EQ(decoder.FastPathHits(), 1 << code_length);
+    }
+}
+
+TEST(DecoderTest, FastPathMatchesFullSearch) {
+    std::mt19937 rng(17);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::uniform_int_distribution<int> position(0, 19);
+
+    for (int code_length : pucch_f2::kValidCodeLengths) {
+        pucch_f2::Decoder fast(code_length);
+        pucch_f2::Decoder full(code_length);
+        full.SetFastPathEnabled(false);
+
+        for (int trial = 0; trial < 20000; ++trial) {
+            // Mostly reliable positive LLRs, so the hard decision is often a codeword.
+            double mean = (trial % 4) * 1.5;
+            std::vector<double> llr(20);
+            for (double& value : llr) {
+                value = mean + noise(rng);
+            }
+            if (trial % 10 == 0) {
+                llr[position(rng)] = 0.0;
+            }
+
+            ASSERT_EQ(fast.DecodeIndex(llr), full.DecodeIndex(llr))
+                << "Length " << code_length << ", trial " << trial;
+        }
+
+        EXPECT_GT(fast.FastPathHits(), 0);
+        EXPECT_EQ(full.FastPathHits(), 0);
+    }
+}
@@ -0,0 +1,72 @@
+#include "latency_benchmark.hpp"
+#include "latency_histogram.hpp"
+#include <gtest/gtest.h>
+
+using pucch_f2::LatencyHistogram;
+
+TEST(LatencyHistogramTest, BucketsAreContiguous) {
+    for (int index = 0; index + 1 < LatencyHistogram::kNumBuckets; ++index) {
+        uint64_t upper = LatencyHistogram::BucketUpperBound(index);
+        ASSERT_EQ(LatencyHistogram::BucketIndex(LatencyHistogram::BucketLowerBound(index)), index);
+        ASSERT_EQ(LatencyHistogram::BucketIndex(upper), index);
+        ASSERT_EQ(LatencyHistogram::BucketLowerBound(index + 1), upper + 1);
+    }
+    EXPECT_EQ(LatencyHistogram::BucketIndex(UINT64_MAX), LatencyHistogram::kNumBuckets - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketPrecision) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100000; ++value) {
+        histogram.Record(value);
+    }
+
+    EXPECT_EQ(histogram.Count(), 100000u);
+    EXPECT_EQ(histogram.Min(), 1u);
+    EXPECT_EQ(histogram.Max(), 100000u);
+    EXPECT_DOUBLE_EQ(histogram.Mean(), 50000.5);
+
+    for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+        double exact = percentile * 1000.0;
+        double reported = static_cast<double>(histogram.Percentile(percentile));
+        EXPECT_GE(reported, exact) << percentile;
+        EXPECT_LE(reported, exact * (1.0 + 1.0 / LatencyHistogram::kSubBuckets)) << percentile;
+    }
+    EXPECT_EQ(histogram.Percentile(100.0), 100000u);
+    EXPECT_THROW(histogram.Percentile(101.0), std::invalid_argument);
+}
+
+TEST(LatencyHistogramTest, MergeMatchesSingleHistogram) {
+    LatencyHistogram all;
+    LatencyHistogram low;
+    LatencyHistogram high;
+    for (uint64_t value = 0; value < 5000; value += 7) {
+        all.Record(value * value);
+        (value < 2500 ? low : high).Record(value * value);
+    }
+
+    low.Merge(high);
+    EXPECT_EQ(low.Count(), all.Count());
+    EXPECT_EQ(low.Min(), all.Min());
+    EXPECT_EQ(low.Max(), all.Max());
+    EXPECT_EQ(low.Percentile(99.0), all.Percentile(99.0));
+}
+
+TEST(LatencyBenchmarkTest, RecordsEveryTimedFrame) {
+    pucch_f2::LatencyBenchmarkOptions options;
+    options.snr_db = 10.0;
+    options.iterations = 3000;
+    options.warmup_iterations = 500;
+    options.deadline_us = 1e6;
+    options.load_threads = 1;
+
+    auto result = pucch_f2::LatencyBenchmark(options, 7).Run(4);
+
+    EXPECT_EQ(result.decode.Count(), 3000u);
+    EXPECT_EQ(result.demod_decode.Count(), 3000u);
+    EXPECT_EQ(result.deadline_misses, 0);
+    EXPECT_EQ(result.failed, 0);
+    EXPECT_LE(result.decode.Percentile(50.0), result.demod_decode.Percentile(50.0));
+
+    options.iterations = 0;
+    EXPECT_THROW(pucch_f2::LatencyBenchmark(options, 7), std::invalid_argument);
+}
@@ -0,0 +1,92 @@
+#include "pipeline.hpp"
+#include "spsc_queue.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(SpscQueueTest, CapacityRoundedToPowerOfTwo) {
+    pucch_f2::SpscQueue<int> queue(5);
+    EXPECT_EQ(queue.Capacity(), 8u);
+    EXPECT_THROW(pucch_f2::SpscQueue<int>(0), std::invalid_argument);
+}
+
+TEST(SpscQueueTest, FullAndEmpty) {
+    pucch_f2::SpscQueue<int> queue(2);
+    int value = 0;
+
+    EXPECT_FALSE(queue.TryPop(value));
+    EXPECT_TRUE(queue.TryPush(1));
+    EXPECT_TRUE(queue.TryPush(2));
+    EXPECT_FALSE(queue.TryPush(3));
+    EXPECT_EQ(queue.Size(), 2u);
+
+    EXPECT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscQueueTest, PreservesOrderAcrossThreads) {
+    const int count = 100000;
+    pucch_f2::SpscQueue<int> queue(16);
+
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) {
+            while (!queue.TryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    while (expected < count) {
+        int value;
+        if (queue.TryPop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST(PipelineTest, MatchesSerialRun) {
+    const pucch_f2::FrameRange range = {pucch_f2::kFramesPerBatch,
+                                        6 * pucch_f2::kFramesPerBatch + 123};
+
+    pucch_f2::ChannelSimulator serial(4, -6.0, 7);
+    auto expected = serial.Run(range);
+
+    pucch_f2::PipelineOptions options;
+    options.queue_capacity = 1;
+    pucch_f2::PipelineSimulator pipeline(4, -6.0, 7, options);
+    auto result = pipeline.Run(range);
+
+    EXPECT_EQ(result.frames, expected.frames);
+    EXPECT_EQ(result.success, expected.success);
+    EXPECT_EQ(result.failed, expected.failed);
+
+    for (const auto& stage : pipeline.Stats().stages) {
+        EXPECT_EQ(stage.batches, 6) << "Stage " << stage.name;
+    }
+}
+
+TEST(PipelineTest, EmptyRangeKeepsStatisticsShape) {
+    pucch_f2::PipelineSimulator pipeline(6, 0.0, 7, pucch_f2::PipelineOptions());
+    auto result = pipeline.Run({2048, 2048});
+
+    EXPECT_EQ(result.frames, 0);
+    EXPECT_EQ(result.bit_errors.size(), 6u);
+    EXPECT_EQ(result.error_weights.size(), 7u);
+}
+
+TEST(PipelineTest, InvalidOptions) {
+    pucch_f2::PipelineOptions options;
+    options.pin_cores = {0, 1};
+    EXPECT_THROW(pucch_f2::PipelineSimulator(2, 0.0, 1, options), std::invalid_argument);
+
+    options.pin_cores.clear();
+    options.queue_capacity = 0;
+    EXPECT_THROW(pucch_f2::PipelineSimulator(2, 0.0, 1, options), std::invalid_argument);
+}
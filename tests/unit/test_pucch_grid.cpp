@@ -0,0 +1,78 @@
+#include "modulator.hpp"
+#include "pucch_grid.hpp"
+#include "pucch_simulation.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+
+TEST(PucchGridTest, BaseSequenceIsUnimodular) {
+    for (const auto& value : pucch_f2::BaseSequence()) {
+        EXPECT_NEAR(std::abs(value), 1.0, 1e-12);
+    }
+}
+
+TEST(PucchGridTest, JointDespreadingSeparatesAllUes) {
+    std::mt19937 rng(3);
+    std::bernoulli_distribution bit;
+    std::normal_distribution<double> gain(0.0, 1.0);
+    pucch_f2::QpskModulator modulator;
+
+    pucch_f2::ResourceGrid grid{};
+    std::vector<std::vector<std::complex<double>>> sent(pucch_f2::kNumCyclicShifts);
+    std::vector<std::complex<double>> channels(pucch_f2::kNumCyclicShifts);
+
+    for (int shift = 0; shift < pucch_f2::kNumCyclicShifts; ++shift) {
+        std::vector<uint8_t> codeword(2 * pucch_f2::kNumDataSymbols);
+        for (auto& b : codeword) {
+            b = bit(rng);
+        }
+        sent[shift] = modulator.Modulate(codeword);
+        channels[shift] = {gain(rng), gain(rng)};
+        pucch_f2::PucchGridMapper(shift).Map(sent[shift], channels[shift], grid);
+    }
+
+    pucch_f2::PucchGridReceiver receiver;
+    pucch_f2::ResourceGrid despread;
+    receiver.Despread(grid, despread);
+
+    for (int shift = 0; shift < pucch_f2::kNumCyclicShifts; ++shift) {
+        auto estimate = pucch_f2::PucchGridReceiver::EstimateChannel(despread, shift);
+        EXPECT_NEAR(std::abs(estimate - channels[shift]), 0.0, 1e-12);
+
+        auto symbols = pucch_f2::PucchGridReceiver::Equalize(despread, shift, estimate);
+        for (int i = 0; i < pucch_f2::kNumDataSymbols; ++i) {
+            EXPECT_NEAR(std::abs(symbols[i] - sent[shift][i]), 0.0, 1e-12);
+        }
+    }
+}
+
+TEST(PucchGridTest, InvalidCyclicShift) {
+    EXPECT_THROW(pucch_f2::PucchGridMapper(12), std::invalid_argument);
+    EXPECT_THROW(pucch_f2::PucchGridMapper(-1), std::invalid_argument);
+}
+
+TEST(PucchSimulationTest, FullyLoadedPrbDecodesAtHighSnr) {
+    pucch_f2::PucchSimulator simulator(11, 5.0, 12, pucch_f2::FadingModel::kAwgn, 11);
+    auto result = simulator.Run({0, 200});
+
+    EXPECT_EQ(result.stats.frames, 200 * 12);
+    EXPECT_EQ(result.stats.failed, 0);
+    ASSERT_EQ(result.failed_per_ue.size(), 12u);
+}
+
+TEST(PucchSimulationTest, ChannelEstimationErrorMatchesNoiseLevel) {
+    const double snr_db = 0.0;
+    pucch_f2::PucchSimulator simulator(2, snr_db, 4, pucch_f2::FadingModel::kRayleigh, 5);
+    auto result = simulator.Run({0, 5000});
+
+    // Per-RE noise variance 2 sigma^2, reduced by 12 subcarriers and 4 DMRS symbols.
+    double sigma = pucch_f2::AwgnChannel::Sigma(snr_db);
+    double expected = 2.0 * sigma * sigma / (pucch_f2::kNumSubcarriers * pucch_f2::kNumDmrsSymbols);
+    EXPECT_NEAR(result.channel_estimation_mse, expected, 0.05 * expected);
+}
+
+TEST(PucchSimulationTest, InvalidParameters) {
+    EXPECT_THROW(pucch_f2::PucchSimulator(4, 0.0, 13, pucch_f2::FadingModel::kAwgn, 1),
+                 std::invalid_argument);
+    EXPECT_THROW(pucch_f2::ParseFadingModel("rician"), std::invalid_argument);
+}
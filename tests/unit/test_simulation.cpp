@@ -0,0 +1,176 @@
+#include "channel.hpp"
+#include "simulation.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+TEST(SimulationTest, ShardRangesCoverIterationSpace) {
+    const int64_t iterations = 10 * pucch_f2::kFramesPerBatch + 17;
+
+    for (int shard_count : {1, 2, 3, 7, 16}) {
+        int64_t expected_first = 0;
+        for (int shard = 0; shard < shard_count; ++shard) {
+            auto range = pucch_f2::ComputeShardRange(iterations, shard, shard_count);
+            EXPECT_EQ(range.first_frame, expected_first);
+            EXPECT_LE(iterations / shard_count, range.last_frame - range.first_frame);
+            EXPECT_LE(range.last_frame - range.first_frame, iterations / shard_count + 1);
+            expected_first = range.last_frame;
+        }
+        EXPECT_EQ(expected_first, iterations) << "Failed for " << shard_count << " shards";
+    }
+}
+
+TEST(SimulationTest, InvalidShard) {
+    EXPECT_THROW(pucch_f2::ComputeShardRange(100, 0, 0), std::invalid_argument);
+    EXPECT_THROW(pucch_f2::ComputeShardRange(100, 2, 2), std::invalid_argument);
+    EXPECT_THROW(pucch_f2::ComputeShardRange(100, -1, 2), std::invalid_argument);
+}
+
+TEST(SimulationTest, ArbitraryRangesMatchFullRun) {
+    pucch_f2::ChannelSimulator single(4, -6.0, 42);
+    auto expected = single.Run({0, 3000});
+
+    pucch_f2::SimulationStats merged;
+    for (pucch_f2::FrameRange range : {pucch_f2::FrameRange{0, 17},
+                                       pucch_f2::FrameRange{17, 1500},
+                                       pucch_f2::FrameRange{1500, 3000}}) {
+        pucch_f2::ChannelSimulator simulator(4, -6.0, 42);
+        merged.Merge(simulator.Run(range));
+    }
+
+    EXPECT_EQ(merged.failed, expected.failed);
+    EXPECT_EQ(merged.bit_errors, expected.bit_errors);
+    EXPECT_THROW(single.Run({10, 5}), std::invalid_argument);
+}
+
+TEST(SimulationTest, MergedShardsMatchSingleRun) {
+    const int64_t iterations = 3 * pucch_f2::kFramesPerBatch + 500;
+
+    pucch_f2::ChannelSimulator single(6, -6.0, 42);
+    auto expected = single.Run({0, iterations});
+
+    pucch_f2::SimulationStats merged;
+    for (int shard = 3; shard >= 0; --shard) {
+        pucch_f2::ChannelSimulator simulator(6, -6.0, 42);
+        merged.Merge(simulator.Run(pucch_f2::ComputeShardRange(iterations, shard, 4)));
+    }
+
+    EXPECT_EQ(merged.frames, iterations);
+    EXPECT_EQ(merged.success, expected.success);
+    EXPECT_EQ(merged.failed, expected.failed);
+}
+
+TEST(SimulationTest, EmptyShardMergesWithOthers) {
+    // 16 shards over 10 frames leave some shards without frames; they must still carry
+    // statistics sized for the code so that merging them is valid.
+    const int64_t iterations = 10;
+
+    pucch_f2::ChannelSimulator single(4, -6.0, 42);
+    auto expected = single.Run({0, iterations});
+
+    pucch_f2::SimulationStats merged;
+    int empty_shards = 0;
+    for (int shard = 0; shard < 16; ++shard) {
+        pucch_f2::ChannelSimulator simulator(4, -6.0, 42);
+        auto stats = simulator.Run(pucch_f2::ComputeShardRange(iterations, shard, 16));
+
+        EXPECT_EQ(stats.bit_errors.size(), 4u);
+        EXPECT_EQ(stats.error_weights.size(), 5u);
+        empty_shards += stats.frames == 0;
+        merged.Merge(stats);
+    }
+
+    EXPECT_GT(empty_shards, 0);
+    EXPECT_EQ(merged.frames, iterations);
+    EXPECT_EQ(merged.failed, expected.failed);
+    EXPECT_EQ(merged.bit_errors, expected.bit_errors);
+    EXPECT_EQ(merged.error_weights, expected.error_weights);
+}
+
+TEST(SimulationTest, WilsonIntervalContainsEstimate) {
+    auto [low, high] = pucch_f2::WilsonInterval(150, 1000);
+    EXPECT_LT(low, 0.15);
+    EXPECT_GT(high, 0.15);
+
+    auto [zero_low, zero_high] = pucch_f2::WilsonInterval(0, 1000);
+    EXPECT_DOUBLE_EQ(zero_low, 0.0);
+    EXPECT_GT(zero_high, 0.0);
+}
+
+TEST(SimulationTest, BitStatisticsConsistent) {
+    const int code_length = 8;
+    pucch_f2::ChannelSimulator simulator(code_length, -8.0, 42);
+    auto stats = simulator.Run({0, 2 * pucch_f2::kFramesPerBatch});
+
+    ASSERT_EQ(stats.bit_errors.size(), static_cast<std::size_t>(code_length));
+    ASSERT_EQ(stats.error_weights.size(), static_cast<std::size_t>(code_length + 1));
+    ASSERT_EQ(stats.decoded_errors.size(), std::size_t{1} << code_length);
+
+    EXPECT_EQ(stats.error_weights[0], stats.success);
+
+    int64_t weighted_errors = 0;
+    int64_t weight_frames = 0;
+    for (int weight = 0; weight <= code_length; ++weight) {
+        weighted_errors += weight * stats.error_weights[weight];
+        weight_frames += stats.error_weights[weight];
+    }
+    EXPECT_EQ(weight_frames, stats.frames);
+    EXPECT_EQ(weighted_errors, stats.TotalBitErrors());
+
+    int64_t decoded_errors = 0;
+    for (int64_t count : stats.decoded_errors) {
+        decoded_errors += count;
+    }
+    EXPECT_EQ(decoded_errors, stats.failed);
+}
+
+TEST(SimulationTest, FailedFramesLogged) {
+    pucch_f2::ChannelSimulator simulator(6, -4.0, 42);
+    simulator.SetFailedFramesLimit(1000000);
+    auto all = simulator.Run({0, 2000});
+
+    ASSERT_EQ(static_cast<int64_t>(all.failed_frames.size()), all.failed);
+    EXPECT_TRUE(std::is_sorted(all.failed_frames.begin(), all.failed_frames.end()));
+
+    simulator.SetFailedFramesLimit(3);
+    auto limited = simulator.Run({0, 2000});
+    ASSERT_EQ(limited.failed_frames.size(), 3u);
+
+    pucch_f2::SimulationStats merged;
+    for (int shard = 1; shard >= 0; --shard) {
+        merged.Merge(simulator.Run({shard * 1000, (shard + 1) * 1000}));
+    }
+    EXPECT_EQ(merged.failed_frames, limited.failed_frames);
+}
+
+TEST(SimulationTest, ReplayReproducesFrame) {
+    pucch_f2::ChannelSimulator simulator(8, -4.0, 42);
+    simulator.SetFailedFramesLimit(5);
+    auto stats = simulator.Run({0, 2000});
+    ASSERT_FALSE(stats.failed_frames.empty());
+
+    pucch_f2::ChannelSimulator replayer(8, -4.0, 42);
+    for (int64_t frame : stats.failed_frames) {
+        auto trace = replayer.ReplayFrame(frame);
+
+        EXPECT_NE(trace.sent_index, trace.decoded_index) << "Frame " << frame;
+        EXPECT_GE(trace.metrics[trace.decoded_index], trace.metrics[trace.sent_index]);
+        // The recorded noise is the channel's own draw for the frame, not received - symbols.
+        pucch_f2::AwgnChannel channel(-4.0, 42);
+        channel.Seek(frame);
+        auto unit_noise = channel.GenerateUnitNoise(trace.symbols.size());
+        const double sigma = pucch_f2::AwgnChannel::Sigma(-4.0);
+
+        ASSERT_EQ(trace.noise.size(), trace.symbols.size());
+        for (std::size_t i = 0; i < trace.symbols.size(); ++i) {
+            EXPECT_NEAR(trace.noise[i].real(), sigma * unit_noise[i].real(), 1e-12);
+            EXPECT_NEAR(trace.noise[i].imag(), sigma * unit_noise[i].imag(), 1e-12);
+            EXPECT_NEAR(std::abs(trace.symbols[i] + trace.noise[i] - trace.received[i]), 0.0,
+                        1e-12);
+        }
+    }
+
+    auto first = replayer.ReplayFrame(1234);
+    auto second = replayer.ReplayFrame(1234);
+    EXPECT_EQ(first.llr, second.llr);
+    EXPECT_THROW(replayer.ReplayFrame(-1), std::invalid_argument);
+}
@@ -0,0 +1,83 @@
+#include "snr_search.hpp"
+#include <gtest/gtest.h>
+
+TEST(SnrSearchTest, InvalidOptions) {
+    pucch_f2::SnrSearchOptions options;
+
+    options.target_bler = 1.5;
+    EXPECT_THROW(pucch_f2::SnrSearch(options, 1), std::invalid_argument);
+
+    options = pucch_f2::SnrSearchOptions();
+    options.snr_low_db = 5.0;
+    options.snr_high_db = -5.0;
+    EXPECT_THROW(pucch_f2::SnrSearch(options, 1), std::invalid_argument);
+
+    options = pucch_f2::SnrSearchOptions();
+    options.max_iterations = options.min_iterations - 1;
+    EXPECT_THROW(pucch_f2::SnrSearch(options, 1), std::invalid_argument);
+}
+
+TEST(SnrSearchTest, BracketsTarget) {
+    pucch_f2::SnrSearchOptions options;
+    options.target_bler = 0.1;
+    options.tolerance_db = 0.25;
+    options.max_iterations = 20000;
+
+    pucch_f2::SnrSearch search(options, 42);
+    auto result = search.Run(2);
+
+    if (!result.probes.back().at_target) {
+        EXPECT_LE(result.snr_high_db - result.snr_low_db, options.tolerance_db);
+    }
+    EXPECT_GT(result.required_snr_db, result.snr_low_db);
+    EXPECT_LT(result.required_snr_db, result.snr_high_db);
+
+    int64_t frames = 0;
+    for (const auto& probe : result.probes) {
+        frames += probe.frames;
+        EXPECT_LE(probe.frames, 20480);
+        if (probe.snr_db <= result.snr_low_db) {
+            EXPECT_TRUE(probe.AboveTarget(options.target_bler)) << "SNR " << probe.snr_db;
+        }
+        if (probe.snr_db >= result.snr_high_db) {
+            EXPECT_FALSE(probe.AboveTarget(options.target_bler)) << "SNR " << probe.snr_db;
+        }
+    }
+    EXPECT_EQ(frames, result.total_frames);
+}
+
+TEST(SnrSearchTest, ExpandsBracket) {
+    pucch_f2::SnrSearchOptions options;
+    options.target_bler = 0.1;
+    options.snr_low_db = 5.0;
+    options.snr_high_db = 6.0;
+    options.tolerance_db = 0.5;
+    options.max_iterations = 4096;
+
+    pucch_f2::SnrSearch search(options, 42);
+    auto result = search.Run(2);
+
+    EXPECT_LT(result.snr_high_db, 5.0);
+
+    // The old lower end is reused as the upper end, not probed again.
+    for (std::size_t i = 0; i < result.probes.size(); ++i) {
+        for (std::size_t j = i + 1; j < result.probes.size(); ++j) {
+            EXPECT_NE(result.probes[i].snr_db, result.probes[j].snr_db);
+        }
+    }
+}
+
+TEST(SnrSearchTest, StopsAtTarget) {
+    pucch_f2::SnrSearchOptions options;
+    options.tolerance_db = 0.1;
+
+    pucch_f2::SnrSearch search(options, 3121113U);
+    auto result = search.Run(6);
+
+    ASSERT_TRUE(result.probes.back().at_target);
+    EXPECT_TRUE(result.resolved);
+    EXPECT_EQ(result.required_snr_db, result.probes.back().snr_db);
+    EXPECT_LT(result.probes.back().frames, options.max_iterations);
+    EXPECT_LT(result.probes.back().bler_ci_low, options.target_bler);
+    EXPECT_GT(result.probes.back().bler_ci_high, options.target_bler);
+}
@@ -0,0 +1,52 @@
+#include "symbol_io.hpp"
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <random>
+
+TEST(SymbolIoTest, FormatMatchesPrintf) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-3.0, 3.0);
+
+    char expected[64];
+    for (int i = 0; i < 1000; ++i) {
+        std::complex<double> value(dist(gen), dist(gen));
+        std::snprintf(expected, sizeof(expected), "%.3f%+.3fj", value.real(), value.imag());
+        EXPECT_EQ(pucch_f2::FormatComplex(value), expected);
+    }
+
+    EXPECT_EQ(pucch_f2::FormatComplex({0.0, -0.0}), "0.000-0.000j");
+    EXPECT_EQ(pucch_f2::FormatComplex({-1e300, 1e300}).size(), 2 * (1 + 301 + 4) + 1);
+}
+
+TEST(SymbolIoTest, ParseValidSymbols) {
+    std::complex<double> value;
+
+    ASSERT_TRUE(pucch_f2::ParseComplex("0.707-0.707j", value));
+    EXPECT_DOUBLE_EQ(value.real(), 0.707);
+    EXPECT_DOUBLE_EQ(value.imag(), -0.707);
+
+    ASSERT_TRUE(pucch_f2::ParseComplex("+1+2j", value));
+    EXPECT_EQ(value, std::complex<double>(1.0, 2.0));
+
+    ASSERT_TRUE(pucch_f2::ParseComplex("-1.5e-3+2E1j", value));
+    EXPECT_EQ(value, std::complex<double>(-1.5e-3, 20.0));
+}
+
+TEST(SymbolIoTest, ParseRejectsMalformedSymbols) {
+    std::complex<double> value(5.0, 5.0);
+
+    for (const char* text : {"", "j", "0.707", "0.707+0.707", "0.707 +0.707j", "0.707+-0.707j",
+                             "0.707+0.707jj", "0.707+0.707i", "a+bj", "0.707+j"}) {
+        EXPECT_FALSE(pucch_f2::ParseComplex(text, value)) << text;
+    }
+    EXPECT_EQ(value, std::complex<double>(5.0, 5.0));
+}
+
+TEST(SymbolIoTest, RoundTrip) {
+    std::complex<double> value;
+
+    for (const char* text : {"0.707+0.707j", "-0.707-0.707j", "12.345-0.001j", "0.000+0.000j"}) {
+        ASSERT_TRUE(pucch_f2::ParseComplex(text, value));
+        EXPECT_EQ(pucch_f2::FormatComplex(value), text);
+    }
+}
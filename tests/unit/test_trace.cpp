@@ -0,0 +1,58 @@
+#include "trace.hpp"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+
+TEST(TraceTest, DisabledSpansAreNotRecorded) {
+    if (pucch_f2::trace::IsEnabled()) {
+        GTEST_SKIP() << "Tracing was already enabled by another test";
+    }
+
+    std::size_t before = pucch_f2::trace::EventCount();
+    { pucch_f2::trace::ScopedSpan span("disabled"); }
+    EXPECT_EQ(pucch_f2::trace::EventCount(), before);
+}
+
+TEST(TraceTest, RecordsSpansFromAllThreads) {
+    pucch_f2::trace::Enable();
+    std::size_t before = pucch_f2::trace::EventCount();
+
+    { pucch_f2::trace::ScopedSpan span("main span"); }
+    std::thread worker([] {
+        pucch_f2::trace::SetThreadName("test worker");
+        pucch_f2::trace::ScopedSpan span("worker span");
+    });
+    worker.join();
+
+    EXPECT_EQ(pucch_f2::trace::EventCount(), before + 2);
+
+    const std::string path = "test_trace.json";
+    pucch_f2::trace::WriteChromeTrace(path);
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(content.str().rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(content.str().find("\"name\":\"worker span\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(content.str().find("\"args\":{\"name\":\"test worker\"}"), std::string::npos);
+}
+
+TEST(TraceTest, DropsSpansBeyondThreadCap) {
+    pucch_f2::trace::Enable();
+    std::size_t before = pucch_f2::trace::EventCount();
+    std::size_t dropped_before = pucch_f2::trace::DroppedEventCount();
+
+    std::thread worker([] {
+        for (std::size_t i = 0; i < pucch_f2::trace::kMaxEventsPerThread + 10; ++i) {
+            pucch_f2::trace::ScopedSpan span("capped span");
+        }
+    });
+    worker.join();
+
+    EXPECT_EQ(pucch_f2::trace::EventCount(), before + pucch_f2::trace::kMaxEventsPerThread);
+    EXPECT_EQ(pucch_f2::trace::DroppedEventCount(), dropped_before + 10);
+}